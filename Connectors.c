@@ -0,0 +1,189 @@
+﻿#include "Random.h"
+#include "Connectors.h"
+#include <stdlib.h>
+#include "Log.h"
+
+/* A connector is a straight run of empty cells with a different region at each end.
+ * We only ever look east and south from the start cell,
+ * the west and north runs are the same connectors seen from their other end!
+ */
+typedef struct Connector {
+    int startX;
+    int startY;
+    int direction;  // 0 = East, 1 = South
+    int length;     // Empty cells to carve, 1 .. MAX_CONNECTOR_LENGTH
+} Connector;
+
+static const int connectorDirX[] = { 1, 0 };
+static const int connectorDirY[] = { 0, 1 };
+
+// Doors always sit right next to a room, so that's where a carved cell becomes one
+static bool TouchesRoom(int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
+{
+    return (IS_IN_GRID(x, y - 1) && IS_ROOM(grid[y - 1][x])) ||
+           (IS_IN_GRID(x + 1, y) && IS_ROOM(grid[y][x + 1])) ||
+           (IS_IN_GRID(x, y + 1) && IS_ROOM(grid[y + 1][x])) ||
+           (IS_IN_GRID(x - 1, y) && IS_ROOM(grid[y][x - 1]));
+}
+
+// Walks from a region cell across empty cells, and records a connector if it lands in another region
+static void FindConnector(int grid[GRID_HEIGHT][GRID_WIDTH], CorridorRegions* regions,
+                          int x, int y, int direction, Connector* connectors, int* connectorCount)
+{
+    const int startRegion = FindRegion(regions, x, y);
+
+    for (int length = 1; length <= MAX_CONNECTOR_LENGTH + 1; length++)
+    {
+        const int checkX = x + connectorDirX[direction] * length;
+        const int checkY = y + connectorDirY[direction] * length;
+
+        if (!IS_VALID_CELL(checkX, checkY))
+        {
+            return;
+        }
+
+        if (IS_EMPTY(grid[checkY][checkX]))
+        {
+            continue;
+        }
+
+        const int endRegion = FindRegion(regions, checkX, checkY);
+
+        // Only a run of at least one empty cell into a *different* region counts
+        if (length > 1 && endRegion != REGION_NONE && endRegion != startRegion)
+        {
+            connectors[(*connectorCount)++] = (Connector){ x, y, direction, length - 1 };
+        }
+
+        return;
+    }
+}
+
+/* Our Kruskal-style connection stage!
+ *
+ * Instead of chaining rooms together with a BFS per pair, we:
+ * 1. Enumerate every connector between two regions (rooms and maze segments) once,
+ * 2. Shuffle them, then bucket them by length, shortest first,
+ * 3. Walk the list a single time, carving a connector only if its ends are still in different regions.
+ *
+ * That's exactly Kruskal's minimum spanning tree with connector length as the weight,
+ * so everything that can be connected ends up connected, with no loops and no searches!
+ * The shuffle is only there to break ties randomly, otherwise every floor would favour the top left.
+ */
+bool ConnectRegions(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount,
+                    CorridorRegions* regions, GenerationStats* stats)
+{
+    if (roomCount <= 0)
+    {
+        return false;
+    }
+
+    // At most one connector east and one south per cell
+    Connector* connectors = malloc(2 * GRID_SIZE * sizeof(Connector));
+    Connector* sorted = malloc(2 * GRID_SIZE * sizeof(Connector));
+
+    if (connectors == NULL || sorted == NULL)
+    {
+        GAME_LOG_ERROR("Connector allocation failed!");
+        free(connectors);
+        free(sorted);
+        return false;
+    }
+
+    int connectorCount = 0;
+
+    for (int y = 1; y < GRID_HEIGHT - 1; y++)
+    {
+        for (int x = 1; x < GRID_WIDTH - 1; x++)
+        {
+            if (FindRegion(regions, x, y) == REGION_NONE)
+            {
+                continue;
+            }
+
+            FindConnector(grid, regions, x, y, 0, connectors, &connectorCount);
+            FindConnector(grid, regions, x, y, 1, connectors, &connectorCount);
+        }
+    }
+
+    stats->connectorCandidates += connectorCount;
+
+    // Here, I use a Fisher-Yates shuffle so equal length connectors come out in a random order
+    for (int i = connectorCount - 1; i > 0; i--)
+    {
+        const int j = GetRandomInt(0, i);
+        const Connector temp = connectors[i];
+
+        connectors[i] = connectors[j];
+        connectors[j] = temp;
+    }
+
+    /* A counting sort by length keeps the shuffled order within each length,
+     * and unlike qsort it gives the same result with every C library!
+     */
+    int bucketStart[MAX_CONNECTOR_LENGTH + 2] = { 0 };
+
+    for (int i = 0; i < connectorCount; i++)
+    {
+        bucketStart[connectors[i].length + 1]++;
+    }
+
+    for (int length = 1; length <= MAX_CONNECTOR_LENGTH + 1; length++)
+    {
+        bucketStart[length] += bucketStart[length - 1];
+    }
+
+    for (int i = 0; i < connectorCount; i++)
+    {
+        sorted[bucketStart[connectors[i].length]++] = connectors[i];
+    }
+
+    // The single pass, ends already sharing a region would only make a loop
+    for (int i = 0; i < connectorCount; i++)
+    {
+        const Connector connector = sorted[i];
+        const int endX = connector.startX + connectorDirX[connector.direction] * (connector.length + 1);
+        const int endY = connector.startY + connectorDirY[connector.direction] * (connector.length + 1);
+
+        if (FindRegion(regions, connector.startX, connector.startY) == FindRegion(regions, endX, endY))
+        {
+            continue;
+        }
+
+        for (int step = 1; step <= connector.length; step++)
+        {
+            const int carveX = connector.startX + connectorDirX[connector.direction] * step;
+            const int carveY = connector.startY + connectorDirY[connector.direction] * step;
+
+            // An earlier connector may have crossed this one, that cell is already walkable
+            if (!IS_EMPTY(grid[carveY][carveX]))
+            {
+                continue;
+            }
+
+            grid[carveY][carveX] = TouchesRoom(grid, carveX, carveY) ? CELL_DOOR : CELL_PATH;
+            AddRegionCell(regions, carveX, carveY);
+            stats->connectorCellsPlaced++;
+        }
+
+        stats->connectorsCarved++;
+    }
+
+    free(connectors);
+    free(sorted);
+
+    // Every room has to share the first room's region, otherwise the floor is unplayable
+    const int firstRoomRegion = FindRegion(regions, rooms[0].x, rooms[0].y);
+    bool allConnected = true;
+
+    for (int i = 1; i < roomCount; i++)
+    {
+        if (FindRegion(regions, rooms[i].x, rooms[i].y) != firstRoomRegion)
+        {
+            GAME_LOG_WARN("Room %d is not connected!", i);
+            allConnected = false;
+        }
+    }
+
+    return allConnected;
+}
\ No newline at end of file
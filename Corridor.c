@@ -1,8 +1,8 @@
-﻿#include <raylib.h>
+﻿#include "Random.h"
 #include "Dungeon.h"
 #include "Corridor.h"
 #include <stdlib.h>
-#include <stdio.h>
+#include "Log.h"
 
 /* This is our general check if we can generate corridors on cells in the grid!
  * We first check the grid boundaries, then,
@@ -48,7 +48,7 @@ bool IsValidCorridorCell(int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
                 int xDist = abs(cx);
                 int yDist = abs(cy);
 
-                if (grid[newY][newX] >= ROOM_ID_START && ((xDist == 1 && yDist == 1) || (xDist + yDist < 2)))
+                if (IS_ROOM(grid[newY][newX]) && ((xDist == 1 && yDist == 1) || (xDist + yDist < 2)))
                 {
                     return false; // Too close to room corner or room
                 }
@@ -82,7 +82,7 @@ bool IsValidCorridorCell(int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
 const int dirX[] = {0, 1, 0, -1};  // North, East, South, West
 const int dirY[] = {-1, 0, 1, 0};  // North, East, South, West
 
-void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int startY)
+void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int startY, GenerationStats* stats)
 {
     // Early validation of parameters before allocation
     if (!IS_IN_GRID(startX, startY))
@@ -111,6 +111,7 @@ void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int star
     {
         stack[stackSize++] = (Corridor){ startX, startY };
         grid[startY][startX] = CELL_CORRIDOR;
+        stats->corridorCellsCarved++;
     }
 
     const int DIRECTION_BIAS_THRESHOLD = 40;  // 60% chance to continue in the same direction!
@@ -148,7 +149,7 @@ void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int star
             int dirIndex;
 
             // Introducing direction bias!
-            const int randomChance = GetRandomValue(0, 100); // cache random value
+            const int randomChance = GetRandomInt(0, 100); // cache random value
 
             if (lastDir >= 0 && randomChance > DIRECTION_BIAS_THRESHOLD) // 70% chance to continue same direction
             {
@@ -170,7 +171,7 @@ void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int star
             // If we couldn't continue in same direction, pick a random available direction!
             if (!foundValidDirection)
             {
-                dirIndex = GetRandomValue(0, numValidDirections - 1);
+                dirIndex = GetRandomInt(0, numValidDirections - 1);
             }
 
             // This keeps track of which direction we chose!
@@ -186,6 +187,7 @@ void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int star
 
             grid[midY][midX] = CELL_CORRIDOR;    // Set middle cell to corridor
             grid[newY][newX] = CELL_CORRIDOR;    // Set destination cell to corridor
+            stats->corridorCellsCarved += 2;
 
             // Add new position to stack
             if (stackSize < stackCapacity)
@@ -203,14 +205,14 @@ void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int star
 
     if (iterations >= MAX_ITERATIONS)
     {
-        printf("RandomizedFloodFill exceeded maximum iterations at (%d, %d)!\n", startX, startY);
+        GAME_LOG_WARN("RandomizedFloodFill exceeded maximum iterations at (%d, %d)!", startX, startY);
     }
 
     free(stack); // Free stack memory!
 }
 
 // Here, we generate our mazes from multiple points!
-void GenerateMazes(int grid[GRID_HEIGHT][GRID_WIDTH])
+void GenerateMazes(int grid[GRID_HEIGHT][GRID_WIDTH], GenerationStats* stats)
 {
     /* Instead of writing " 4 ", we use a constant for processing speed.
      * Apparently, this form of caching is faster than using direct value, at least theoretically,
@@ -226,7 +228,8 @@ void GenerateMazes(int grid[GRID_HEIGHT][GRID_WIDTH])
         {
             if (IS_IN_GRID(j, i) && IsValidCorridorCell(grid, j, i))
             {
-                RandomizedFloodFill(grid, j, i);
+                stats->mazeFloodFillSeeds++;
+                RandomizedFloodFill(grid, j, i, stats);
             }
         }
     }
@@ -0,0 +1,91 @@
+﻿#include "DistanceField.h"
+#include "Regions.h"
+
+static const int fieldDirX[] = { 0, 1, 0, -1 };
+static const int fieldDirY[] = { -1, 0, 1, 0 };
+
+/* Plain BFS over empty cells, starting from whatever is already queued.
+ * Every source sits at distance 0, so the first time we reach a cell is also the shortest,
+ * and a cell is never queued twice!
+ */
+static void SpreadDistances(DistanceField* field, int grid[GRID_HEIGHT][GRID_WIDTH], int queueBack)
+{
+    int queueFront = 0;
+
+    while (queueFront < queueBack)
+    {
+        const int index = field->queue[queueFront++];
+        const int x = index % GRID_WIDTH;
+        const int y = index / GRID_WIDTH;
+        const int nextDistance = field->distance[index] + 1;
+
+        for (int i = 0; i < 4; i++)
+        {
+            const int newX = x + fieldDirX[i];
+            const int newY = y + fieldDirY[i];
+
+            if (!IS_IN_GRID(newX, newY) || !IS_EMPTY(grid[newY][newX]))
+            {
+                continue;
+            }
+
+            const int newIndex = GET_GRID_INDEX(newX, newY);
+
+            if (field->distance[newIndex] > nextDistance)
+            {
+                field->distance[newIndex] = nextDistance;
+                field->queue[queueBack++] = newIndex;
+            }
+        }
+    }
+}
+
+// Every corridor, path and door cell is a source, call this right after GenerateMazes
+void BuildCorridorDistanceField(DistanceField* field, int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    int queueBack = 0;
+
+    for (int i = 0; i < GRID_SIZE; i++)
+    {
+        if (IS_REGION_CELL(grid[i / GRID_WIDTH][i % GRID_WIDTH]))
+        {
+            field->distance[i] = 0;
+            field->queue[queueBack++] = i;
+        }
+        else
+        {
+            field->distance[i] = DISTANCE_UNREACHABLE;
+        }
+    }
+
+    SpreadDistances(field, grid, queueBack);
+}
+
+/* Call this after carving new corridor, path or door cells, with their grid indices as sources.
+ * Only the cells that got closer to a corridor are visited, which is usually a handful!
+ */
+void RelaxDistanceField(DistanceField* field, int grid[GRID_HEIGHT][GRID_WIDTH], const int sources[], int sourceCount)
+{
+    int queueBack = 0;
+
+    for (int i = 0; i < sourceCount; i++)
+    {
+        if (field->distance[sources[i]] != 0)
+        {
+            field->distance[sources[i]] = 0;
+            field->queue[queueBack++] = sources[i];
+        }
+    }
+
+    SpreadDistances(field, grid, queueBack);
+}
+
+int GetFieldDistance(const DistanceField* field, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return DISTANCE_UNREACHABLE;
+    }
+
+    return field->distance[GET_GRID_INDEX(x, y)];
+}
\ No newline at end of file
@@ -0,0 +1,289 @@
+﻿#include "DistanceMap.h"
+#include <stdlib.h>
+
+// Same moves as the player, 4 straight then 4 diagonal
+static const int mapDirX[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+static const int mapDirY[] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+
+// IsWalkable without the call, this runs 8 times for every cell we visit
+#define MAP_WALKABLE(masks, x, y) (IS_IN_GRID(x, y) && GET_GRID_BIT(&(masks)->walkable, x, y))
+
+void ClearDistanceMap(DistanceMap* map)
+{
+    for (int i = 0; i < GRID_SIZE; i++)
+    {
+        map->distance[i] = DISTANCE_MAP_UNREACHABLE;
+    }
+
+    map->sourceX = -1;
+    map->sourceY = -1;
+}
+
+/* Bucket queue Dijkstra, where every step costs exactly one turn.
+ * With unit costs bucket k is just the run of the queue holding distance k, and the next bucket
+ * is always appended behind it, so one FIFO array is the whole queue!
+ *
+ * Only cells that get closer are queued, so this both builds a map from scratch (everything at
+ * DISTANCE_MAP_UNREACHABLE) and lowers an existing one. Returns how many cells were lowered.
+ */
+static int LowerDistances(DistanceMap* map, const FloorMasks* masks, GridBits* lowered, int queueBack)
+{
+    int queueFront = 0;
+
+    while (queueFront < queueBack)
+    {
+        const int index = map->queue[queueFront++];
+        const int x = index % GRID_WIDTH;
+        const int y = index / GRID_WIDTH;
+        const int nextDistance = map->distance[index] + 1;
+
+        for (int i = 0; i < 8; i++)
+        {
+            const int newX = x + mapDirX[i];
+            const int newY = y + mapDirY[i];
+
+            if (!MAP_WALKABLE(masks, newX, newY))
+            {
+                continue;
+            }
+
+            const int newIndex = GET_GRID_INDEX(newX, newY);
+
+            if (map->distance[newIndex] > nextDistance)
+            {
+                map->distance[newIndex] = nextDistance;
+                map->queue[queueBack++] = newIndex;
+
+                if (lowered != NULL)
+                {
+                    SET_GRID_BIT(lowered, newX, newY);
+                }
+            }
+        }
+    }
+
+    return queueBack;
+}
+
+void BuildDistanceMap(DistanceMap* map, const FloorMasks* masks, int sourceX, int sourceY)
+{
+    ClearDistanceMap(map);
+
+    if (!IsWalkable(masks, sourceX, sourceY))
+    {
+        return;
+    }
+
+    map->sourceX = sourceX;
+    map->sourceY = sourceY;
+
+    const int sourceIndex = GET_GRID_INDEX(sourceX, sourceY);
+    map->distance[sourceIndex] = 0;
+    map->queue[0] = sourceIndex;
+
+    LowerDistances(map, masks, NULL, 1);
+}
+
+/* Every walkable cell set in sources starts at 0, so each cell ends up with the distance to the nearest one.
+ * A map like this has no single source, so the next MoveDistanceMapSource always does a full build!
+ */
+void BuildDistanceMapFromMask(DistanceMap* map, const FloorMasks* masks, const GridBits* sources)
+{
+    ClearDistanceMap(map);
+
+    int queueBack = 0;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (GET_GRID_BIT(sources, x, y) && GET_GRID_BIT(&masks->walkable, x, y))
+            {
+                const int index = GET_GRID_INDEX(x, y);
+                map->distance[index] = 0;
+                map->queue[queueBack++] = index;
+            }
+        }
+    }
+
+    LowerDistances(map, masks, NULL, queueBack);
+}
+
+/* Every cell in order is a source starting from whatever value it has now (any int, negative is fine),
+ * and we settle the map so no cell is more than one step above a neighbour.
+ * order must list the sources by their current value, lowest first, the caller usually gets that for free
+ * from how it made the values (a counting sort, a BFS order...).
+ * Cells are never lowered to a value above ceiling, which keeps the spread local when the sources are.
+ *
+ * Still a bucket queue! The sorted sources and the FIFO of lowered cells are both in order,
+ * so always taking the lower of their two fronts hands us cells in order, and nothing gets lowered twice.
+ * Returns how many cells were lowered, they are map->queue[0 .. count - 1].
+ */
+int SettleDistanceMap(DistanceMap* map, const FloorMasks* masks, const int order[], int orderCount, int ceiling)
+{
+    int next = 0;
+    int queueFront = 0;
+    int queueBack = 0;
+
+    for (;;)
+    {
+        int index;
+
+        if (next < orderCount &&
+            (queueFront == queueBack || map->distance[order[next]] <= map->distance[map->queue[queueFront]]))
+        {
+            index = order[next++];
+        }
+        else if (queueFront < queueBack)
+        {
+            index = map->queue[queueFront++];
+        }
+        else
+        {
+            break;
+        }
+
+        const int x = index % GRID_WIDTH;
+        const int y = index / GRID_WIDTH;
+        const int nextDistance = map->distance[index] + 1;
+
+        if (nextDistance > ceiling)
+        {
+            continue;
+        }
+
+        for (int i = 0; i < 8; i++)
+        {
+            const int newX = x + mapDirX[i];
+            const int newY = y + mapDirY[i];
+
+            if (!MAP_WALKABLE(masks, newX, newY))
+            {
+                continue;
+            }
+
+            const int newIndex = GET_GRID_INDEX(newX, newY);
+
+            if (map->distance[newIndex] > nextDistance)
+            {
+                map->distance[newIndex] = nextDistance;
+                map->queue[queueBack++] = newIndex;
+            }
+        }
+    }
+
+    return queueBack;
+}
+
+// A cell keeps its distance k as long as some neighbour still sits at k - 1
+static bool HasParent(const DistanceMap* map, const FloorMasks* masks, int x, int y, int distance)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        const int newX = x + mapDirX[i];
+        const int newY = y + mapDirY[i];
+
+        if (MAP_WALKABLE(masks, newX, newY) && map->distance[GET_GRID_INDEX(newX, newY)] == distance - 1)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* The player moved, so the map needs a new source!
+ *
+ * When the new source is next to the old one, no distance can change by more than one turn,
+ * so we only repair the cells that actually changed instead of redoing the whole floor:
+ *  1. Lower: a BFS from the new source, which only spreads through cells that got closer.
+ *  2. Raise: the old source lost its 0, and that spreads outward level by level. A cell at distance k
+ *     only goes up to k + 1 when none of its neighbours are left at k - 1, and only neighbours of a cell
+ *     that just went up can be next.
+ * Every level is finished before the next one starts, so a cell's parents are always final when we check it.
+ *
+ * Anything else (stairs, first move on a floor, a jump across the map) is simply a full build.
+ * The walkable layer must not have changed since the last build!
+ */
+void MoveDistanceMapSource(DistanceMap* map, const FloorMasks* masks, int sourceX, int sourceY)
+{
+    if (sourceX == map->sourceX && sourceY == map->sourceY)
+    {
+        return;
+    }
+
+    if (map->sourceX < 0 || abs(sourceX - map->sourceX) > 1 || abs(sourceY - map->sourceY) > 1 ||
+        !IsWalkable(masks, sourceX, sourceY) || map->distance[GET_GRID_INDEX(sourceX, sourceY)] != 1)
+    {
+        BuildDistanceMap(map, masks, sourceX, sourceY);
+        return;
+    }
+
+    GridBits lowered;
+    GridBits queued;
+    ClearGridBits(&lowered);
+    ClearGridBits(&queued);
+
+    // 1. Lower, the new source drops from 1 to 0 and pulls its side of the floor one turn closer
+    const int sourceIndex = GET_GRID_INDEX(sourceX, sourceY);
+    map->distance[sourceIndex] = 0;
+    map->queue[0] = sourceIndex;
+    SET_GRID_BIT(&lowered, sourceX, sourceY);
+
+    LowerDistances(map, masks, &lowered, 1);
+
+    // 2. Raise, starting from the old source
+    int queueFront = 0;
+    int queueBack = 0;
+
+    map->queue[queueBack++] = GET_GRID_INDEX(map->sourceX, map->sourceY);
+    SET_GRID_BIT(&queued, map->sourceX, map->sourceY);
+
+    while (queueFront < queueBack)
+    {
+        const int index = map->queue[queueFront++];
+        const int x = index % GRID_WIDTH;
+        const int y = index / GRID_WIDTH;
+        const int distance = map->distance[index];
+
+        if (HasParent(map, masks, x, y, distance))
+        {
+            continue;
+        }
+
+        map->distance[index] = distance + 1;
+
+        // Only the next level down can have lost its parent
+        for (int i = 0; i < 8; i++)
+        {
+            const int newX = x + mapDirX[i];
+            const int newY = y + mapDirY[i];
+
+            if (!MAP_WALKABLE(masks, newX, newY) || GET_GRID_BIT(&lowered, newX, newY) || GET_GRID_BIT(&queued, newX, newY))
+            {
+                continue;
+            }
+
+            const int newIndex = GET_GRID_INDEX(newX, newY);
+
+            if (map->distance[newIndex] == distance + 1)
+            {
+                map->queue[queueBack++] = newIndex;
+                SET_GRID_BIT(&queued, newX, newY);
+            }
+        }
+    }
+
+    map->sourceX = sourceX;
+    map->sourceY = sourceY;
+}
+
+int GetMapDistance(const DistanceMap* map, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return DISTANCE_MAP_UNREACHABLE;
+    }
+
+    return map->distance[GET_GRID_INDEX(x, y)];
+}
\ No newline at end of file
@@ -1,24 +1,30 @@
-﻿#include <raylib.h>
+﻿#include "Random.h"
 #include "Dungeon.h"
 #include "Door.h"
+#include "DistanceField.h"
 #include <stdlib.h>
 #include <stdint.h>
-#include <stdio.h>
+#include "Log.h"
 
 /* Here, we attempt to create connections between rooms and corridors,
  * First we allocate memory for a boolean array to keep track of connections,
- * Then, we iterate over each room, and check if we can connect it.
+ * Then, we build a distance field telling us how far every empty cell is from a corridor.
  *
- * We then introduce randomness to door placement with some direction bias,
- * and check if we can place a door!
+ * Each room then reads that field just outside its walls, with some direction bias,
+ * and picks the closest spot for its door!
+ * If that spot isn't right next to a corridor, we walk down the field to the corridor,
+ * placing corridor cells as we go.
  *
- * If we can, we place a door and mark the room as connected.
- * If we cannot, we try to place a door in a random direction, followed by necessary corridor cell.
+ * If no corridor is close enough, we try to place a door in a random direction, followed by necessary corridor cell.
  *
  * The goal is to ensure all rooms are connected by doors and corridors,
  * and that the player can then traverse to each and all rooms!
+ *
+ * Every door and connecting corridor cell we place is added to the corridor regions,
+ * so GeneratePaths sees the networks exactly as we left them.
  */
-bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount)
+bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount,
+                          CorridorRegions* regions, GenerationStats* stats)
 {
     // calloc => runtime heap allocation, initializes 0 (false for bool)
     bool* hasConnection = (bool*)calloc(roomCount, sizeof(bool));
@@ -28,23 +34,44 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
         return false; // Allocation failed!
     }
 
+    /* One multi-source BFS from every corridor cell the mazes left us,
+     * after this, finding the nearest corridor from any cell is a single read!
+     */
+    DistanceField* field = malloc(sizeof(DistanceField));
+
+    if (field == NULL)
+    {
+        free(hasConnection);
+        return false; // Allocation failed!
+    }
+
+    BuildCorridorDistanceField(field, grid);
+
     /* Direction offsets for [checkX, checkY, doorX, doorY] for N, S, W, E directions
      * North: (0, -x, 0, -1)
      * South: (0, +x, 0, +1)
      * West: (-x, 0, -1, 0)
      * East: (+x, 0, +1, 0)
      *
-     * x = cells away to check for corridors (1, 2, or 3 cells away)
+     * x = cells away to check for corridors
      * We also place our door to be adjacent to the room!
      */
     const int8_t d = 1;  // Door distance from room is always 1
 
+    // Outward direction of each wall, N, S, W, E
+    const int wallDirX[4] = { 0, 0, -1, 1 };
+    const int wallDirY[4] = { -1, 1, 0, 0 };
+
     // Grid center for directional biasing
     const int centerY = GRID_HEIGHT / 2;
 
-    // Maximum corridor search distance
+    // Maximum corridor search distance, counted from the wall
     const int MAX_CORRIDOR_DISTANCE = 3;
 
+    // Cells placed for the current room, fed back into the distance field
+    int placedCells[MAX_CORRIDOR_DISTANCE + 2];
+    int placedCount = 0;
+
     for (int roomIndex = 0; roomIndex < roomCount; ++roomIndex)
     {
         // Skip rooms that already have connections
@@ -56,6 +83,7 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
         // Get current room
         Room room = rooms[roomIndex];
         bool doorPlaced = false;
+        placedCount = 0;
 
         // Calculate room center for directional bias
         int roomCenterY = room.y + (room.height / 2);
@@ -84,98 +112,106 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
             wallOrder[3] = 1;  // South
         }
 
-        // Progressive scanning with increasing distances
-        for (int corridorDistance = 1; corridorDistance <= MAX_CORRIDOR_DISTANCE && !doorPlaced; corridorDistance++)
+        /* Here, we read the field along the outside of each wall, once.
+         * The door cell is 1 away from the wall, so a corridor within MAX_CORRIDOR_DISTANCE of the wall
+         * means a field distance below MAX_CORRIDOR_DISTANCE.
+         * Only a strictly closer cell replaces the best one, so ties keep our wall order and middle-first bias!
+         */
+        int bestDistance = MAX_CORRIDOR_DISTANCE;
+        int bestWall = -1;
+        int bestDoorX = 0;
+        int bestDoorY = 0;
+
+        for (int i = 0; i < 4; i++)
         {
-            // Each wall in order!
-            for (int i = 0; i < 4 && !doorPlaced; i++)
+            int wall = wallOrder[i];
+            bool isHorizontal = wall < 2;  // N/S are horizontal walls, W/E are vertical
+
+            int length = isHorizontal ? room.width : room.height;
+
+            /* Changed door scanning pattern: Start from middle of wall and alternate sides
+             * This avoids biasing doors toward room corners and creates more
+             * aesthetically pleasing door placements
+             */
+            int middle = length / 2;
+
+            // Check positions outward from the middle of the wall in alternating pattern
+            // middle, middle+1, middle-1, middle+2, middle-2, etc.
+            for (int offset = 0; offset < length; offset++)
             {
-                int wall = wallOrder[i];
-                bool isHorizontal = wall < 2;  // N/S are horizontal walls, W/E are vertical
+                // Calculate position with alternating offset from middle
+                int pos;
+                if (offset == 0) {
+                    pos = middle;  // Start at exact middle
+                } else {
+                    // Alternate between right and left of middle
+                    int direction = ((offset % 2) == 1) ? 1 : -1;
+                    pos = middle + ((offset + 1) / 2) * direction;
+                }
 
-                // Wall offsets based on current distance
-                const int8_t wallOffsets[4][4] =
-                {
-                    {0, -corridorDistance, 0, -d},    // N
-                    {0, corridorDistance, 0, d},      // S
-                    {-corridorDistance, 0, -d, 0},    // W
-                    {corridorDistance, 0, d, 0}       // E
-                };
+                // Skip invalid positions
+                if (pos < 0 || pos >= length) {
+                    continue;
+                }
 
-                int length = isHorizontal ? room.width : room.height;
+                // The cell just outside the wall
+                int doorX = isHorizontal ? (room.x + pos) : ((wall == 2) ? room.x - d : room.x + room.width);
+                int doorY = isHorizontal ? ((wall == 0) ? room.y - d : room.y + room.height) : (room.y + pos);
 
-                /* Changed door scanning pattern: Start from middle of wall and alternate sides
-                 * This avoids biasing doors toward room corners and creates more
-                 * aesthetically pleasing door placements
-                 */
-                int middle = length / 2;
+                stats->doorCorridorProbes++;
 
-                // Check positions outward from the middle of the wall in alternating pattern
-                // middle, middle+1, middle-1, middle+2, middle-2, etc.
-                for (int offset = 0; offset < length && !doorPlaced; offset++)
+                if (!IS_IN_GRID(doorX, doorY) || !IS_EMPTY(grid[doorY][doorX]))
                 {
-                    // Calculate position with alternating offset from middle
-                    int pos;
-                    if (offset == 0) {
-                        pos = middle;  // Start at exact middle
-                    } else {
-                        // Alternate between right and left of middle
-                        int direction = ((offset % 2) == 1) ? 1 : -1;
-                        pos = middle + ((offset + 1) / 2) * direction;
-                    }
+                    continue;
+                }
 
-                    // Skip invalid positions
-                    if (pos < 0 || pos >= length) {
-                        continue;
-                    }
+                int distance = GetFieldDistance(field, doorX, doorY);
 
-                    int x = isHorizontal ? (room.x + pos) : room.x;
-                    int y = isHorizontal ? room.y : (room.y + pos);
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestWall = wall;
+                    bestDoorX = doorX;
+                    bestDoorY = doorY;
+                }
+            }
+        }
 
-                    // Calculate corridor and door positions
-                    int corridorX = x + wallOffsets[wall][0];
-                    int corridorY = y + wallOffsets[wall][1];
-                    int doorX = x + wallOffsets[wall][2];
-                    int doorY = y + wallOffsets[wall][3];
+        if (bestWall != -1)
+        {
+            // Place door
+            grid[bestDoorY][bestDoorX] = CELL_DOOR;
+            AddRegionCell(regions, bestDoorX, bestDoorY);
+            placedCells[placedCount++] = GET_GRID_INDEX(bestDoorX, bestDoorY);
+
+            /* Here, we add connecting corridors if necessary!
+             * Every step down the field gets us one cell closer to a corridor,
+             * we prefer carrying on straight out of the wall so the connection stays straight.
+             */
+            int fillX = bestDoorX;
+            int fillY = bestDoorY;
+
+            for (int distance = bestDistance; distance > 1; distance--)
+            {
+                int nextX = fillX + wallDirX[bestWall];
+                int nextY = fillY + wallDirY[bestWall];
 
-                    // Check if corridor position is valid and contains a corridor
-                    if (IS_IN_GRID(corridorX, corridorY) && grid[corridorY][corridorX] == CELL_CORRIDOR)
-                    {
-                        if (IS_IN_GRID(doorX, doorY) &&
-                            (grid[doorY][doorX] == CELL_EMPTY_1 || grid[doorY][doorX] == CELL_EMPTY_2))
-                        {
-                            // Place door
-                            grid[doorY][doorX] = CELL_DOOR;
+                for (int dir = 0; dir < 4 && GetFieldDistance(field, nextX, nextY) != distance - 1; dir++)
+                {
+                    nextX = fillX + wallDirX[dir];
+                    nextY = fillY + wallDirY[dir];
+                }
 
-                            // Here, we add connecting corridors if necessary!
-                            if (corridorDistance > 1)
-                            {
-                                // ? : because, sometimes corridors 3 cells away aren't properly connected ^^
-                                int dirX = (corridorX == doorX) ? 0 : ((corridorX > doorX) ? 1 : -1);
-                                int dirY = (corridorY == doorY) ? 0 : ((corridorY > doorY) ? 1 : -1);
-
-                                // Fill corridor cells
-                                for (int step = 1; step < corridorDistance; step++)
-                                {
-                                    int fillX = doorX + dirX * step;
-                                    int fillY = doorY + dirY * step;
-
-                                    if (IS_IN_GRID(fillX, fillY) &&
-                                        (grid[fillY][fillX] == CELL_EMPTY_1 ||
-                                            grid[fillY][fillX] == CELL_EMPTY_2))
-                                    {
-                                        grid[fillY][fillX] = CELL_CORRIDOR;
-                                    }
-                                }
-                            }
+                fillX = nextX;
+                fillY = nextY;
 
-                            hasConnection[roomIndex] = true;
-                            doorPlaced = true;
-                            break;
-                        }
-                    }
-                }
+                grid[fillY][fillX] = CELL_CORRIDOR;
+                AddRegionCell(regions, fillX, fillY);
+                placedCells[placedCount++] = GET_GRID_INDEX(fillX, fillY);
             }
+
+            hasConnection[roomIndex] = true;
+            doorPlaced = true;
         }
 
         /* In the case that no corridors were found within expected range,
@@ -188,7 +224,7 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
             // Here, I use a Fisher-Yates shuffle for a random direction order
             for (int i = 3; i > 0; i--)
             {
-                int j = GetRandomValue(0, i);
+                int j = GetRandomInt(0, i);
                 int temp = directions[i];
 
                 directions[i] = directions[j];
@@ -242,6 +278,8 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
                     {
                         // Place door
                         grid[doorY][doorX] = CELL_DOOR;
+                        AddRegionCell(regions, doorX, doorY);
+                        placedCells[placedCount++] = GET_GRID_INDEX(doorX, doorY);
 
                         // Place corridor cells between door and final corridor position
                         int dirX = (corridorX - doorX) / corridorDistance;
@@ -255,21 +293,27 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
                             if (IS_IN_GRID(fillX, fillY) && !IS_ROOM(grid[fillY][fillX]))
                             {
                                 grid[fillY][fillX] = CELL_CORRIDOR;
+                                AddRegionCell(regions, fillX, fillY);
+                                placedCells[placedCount++] = GET_GRID_INDEX(fillX, fillY);
                             }
                         }
 
                         hasConnection[roomIndex] = true;
                         doorPlaced = true;
+                        stats->doorFallbackPlacements++;
                     }
                 }
             }
         }
 
+        // The next rooms should see this room's connection as a corridor too
+        RelaxDistanceField(field, grid, placedCells, placedCount);
+
         // Report failure if we still couldn't place a door
         if (!doorPlaced)
         {
-            printf("Failed to place door for room %d at position (%d,%d)\n",
-                   roomIndex, room.x, room.y);
+            GAME_LOG_WARN("Failed to place door for room %d at position (%d,%d)",
+                          roomIndex, room.x, room.y);
         }
     }
 
@@ -281,11 +325,12 @@ bool ConnectRoomsViaDoors(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int r
         if (!hasConnection[i])
         {
             allConnected = false;
-            printf("Room %d at (%d,%d) has no connection\n", i, rooms[i].x, rooms[i].y);
+            GAME_LOG_WARN("Room %d at (%d,%d) has no connection", i, rooms[i].x, rooms[i].y);
             break;
         }
     }
 
+    free(field);
     free(hasConnection);
     return allConnected;
 }
@@ -356,6 +401,6 @@ bool FindDoorPosition(int grid[GRID_HEIGHT][GRID_WIDTH], Room room, int* doorX,
     }
 
     // should never happen but just in case
-    printf("No door found for room at (%d, %d)!\n", room.x, room.y);
+    GAME_LOG_WARN("No door found for room at (%d, %d)!", room.x, room.y);
     return false;
 }
\ No newline at end of file
@@ -1,13 +1,20 @@
 ﻿#include <raylib.h>
 #include "Dungeon.h"
-#include <stdio.h>
+#include "Log.h"
+#include <stdlib.h>
+#include <string.h>
 
 // Include all component headers
 #include "Room.h"
 #include "Corridor.h"
 #include "Door.h"
 #include "Path.h"
+#include "Regions.h"
+#include "Connectors.h"
+#include "FloorValidator.h"
 #include "Staircase.h"
+#include "Random.h"
+#include "Trace.h"
 
 /* In this loop we make a simple 2d grid
  * We then colour the grid based on the XOR AND of x and y */
@@ -24,6 +31,7 @@ void GenerateGrid(int grid[GRID_HEIGHT][GRID_WIDTH])
     }
 }
 
+#if !defined(USE_CONNECTOR_STAGE)
 // Here, we define starting and end rooms for our pathfinding algorithm.
 static bool InitializeRoomIndices(Room rooms[], int roomCount, int* startRoomIndex, int* bossRoomIndex)
 {
@@ -55,30 +63,75 @@ static bool InitializeRoomIndices(Room rooms[], int roomCount, int* startRoomInd
         return true;
     }
 
-    printf("Failed to find start or boss room indices!\n");
+    GAME_LOG_WARN("Failed to find start or boss room indices!");
     return false;
 }
+#endif
 
 bool GenerateDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], int maxAttempts, int currentFloor,
-                     Room rooms[], int* roomCount)
+                     Room rooms[], int* roomCount, GenerationStats* stats)
 {
+    TRACE_BEGIN(dungeonZone, "GenerateDungeon");
+
     // Initialize the grid with a checkerboard pattern
     GenerateGrid(grid);
 
     // Step 1: Generate rooms
-    if (!GenerateRooms(grid, rooms, roomCount))
+    TRACE_BEGIN(roomsZone, "GenerateRooms");
+    const bool roomsPlaced = GenerateRooms(grid, rooms, roomCount, stats);
+    TRACE_END(roomsZone);
+
+    if (!roomsPlaced)
     {
-        printf("Room generation failed\n");
+        GAME_LOG_DEBUG("Room generation failed");
+        TRACE_END(dungeonZone);
         return false;
     }
 
     // Step 2: Generate maze-like corridors in empty spaces
-    GenerateMazes(grid);
+    TRACE_BEGIN(mazesZone, "GenerateMazes");
+    GenerateMazes(grid, stats);
+    TRACE_END(mazesZone);
+
+    /* Label the corridor networks the mazes left us with,
+     * doors and paths keep these up to date as they connect things.
+     */
+    CorridorRegions* regions = malloc(sizeof(CorridorRegions));
+    if (regions == NULL)
+    {
+        GAME_LOG_ERROR("Corridor regions allocation failed!");
+        TRACE_END(dungeonZone);
+        return false;
+    }
+
+    LabelCorridorRegions(regions, grid);
+
+#if defined(USE_CONNECTOR_STAGE)
+    // Steps 3-5: Connect rooms and maze segments in a single Kruskal pass
+    TRACE_BEGIN(connectorsZone, "ConnectRegions");
+    AddRoomRegions(regions, rooms, *roomCount);
+    const bool regionsConnected = ConnectRegions(grid, rooms, *roomCount, regions, stats);
+    TRACE_END(connectorsZone);
 
+    free(regions);
+
+    if (!regionsConnected)
+    {
+        GAME_LOG_WARN("Connector stage failed");
+        TRACE_END(dungeonZone);
+        return false;
+    }
+#else
     // Step 3: Connect rooms using doors
-    if (!ConnectRoomsViaDoors(grid, rooms, *roomCount))
+    TRACE_BEGIN(doorsZone, "ConnectRoomsViaDoors");
+    const bool doorsPlaced = ConnectRoomsViaDoors(grid, rooms, *roomCount, regions, stats);
+    TRACE_END(doorsZone);
+
+    if (!doorsPlaced)
     {
-        printf("Door connection failed\n");
+        GAME_LOG_WARN("Door connection failed");
+        free(regions);
+        TRACE_END(dungeonZone);
         return false;
     }
 
@@ -86,42 +139,147 @@ bool GenerateDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], int maxAttempts, int cur
     int startRoomIndex, bossRoomIndex;
     if (!InitializeRoomIndices(rooms, *roomCount, &startRoomIndex, &bossRoomIndex))
     {
-        printf("Room indices initialization failed\n");
+        GAME_LOG_WARN("Room indices initialization failed");
+        free(regions);
+        TRACE_END(dungeonZone);
         return false;
     }
 
     // Step 5: Generate paths between rooms
-    GeneratePaths(grid, rooms, *roomCount, startRoomIndex, bossRoomIndex);
+    TRACE_BEGIN(pathsZone, "GeneratePaths");
+    GeneratePaths(grid, rooms, *roomCount, startRoomIndex, bossRoomIndex, regions, stats);
+    TRACE_END(pathsZone);
+
+    free(regions);
+#endif
 
     // Step 6: Place up and down staircases
+    TRACE_BEGIN(stairsZone, "PlaceStaircases");
     PlaceStaircases(grid, rooms, *roomCount, currentFloor);
+    TRACE_END(stairsZone);
 
+    TRACE_END(dungeonZone);
     return true;
 }
 
-/* Our main print function.
- * Currently, we print a checkerboard pattern using even/odd bits from x/y, determined by GenerateDungeon
+/* Generates a floor purely from a seed, retries included.
+ * The game and the offline floor pack builder both go through here,
+ * so the same seed always gives the exact same floor, wherever it was generated!
+ *
+ * The stats cover every attempt, failed ones are work too.
+ * A floor only counts once the validator agrees the player can actually reach everything,
+ * otherwise we just try again.
  */
-void PrintDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount)
+bool GenerateSeededDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], unsigned int seed, int maxAttempts,
+                           int currentFloor, Room rooms[], int* roomCount, int* attemptsUsed,
+                           GenerationStats* stats)
 {
-    const int totalHeight = GRID_TOTAL_HEIGHT;
-    const int totalWidth = GRID_TOTAL_WIDTH;
+    memset(stats, 0, sizeof(*stats));
+    SeedRandom(seed);
 
-    const int startX = CENTER_SCREEN_X(totalWidth);
-    const int startY = CENTER_SCREEN_Y(totalHeight);
+    for (int attempt = 1; attempt <= maxAttempts; attempt++)
+    {
+        *attemptsUsed = attempt;
 
-    for (int y = 0; y < GRID_HEIGHT; y++)
+        // Clear the grid for fresh generation
+        memset(grid, 0, sizeof(int) * GRID_SIZE);
+
+        if (!GenerateDungeon(grid, maxAttempts, currentFloor, rooms, roomCount, stats))
+        {
+            continue;
+        }
+
+        TRACE_BEGIN(validateZone, "ValidateFloorConnectivity");
+        const uint32_t unreachable = ValidateFloorConnectivity(grid, rooms, *roomCount);
+        TRACE_END(validateZone);
+
+        if (unreachable == FLOOR_REACHABLE)
+        {
+            return true;
+        }
+
+        stats->floorsFailedValidation++;
+        GAME_LOG_WARN("Seed %u attempt %d failed validation (unreachable 0x%08x)", seed, attempt, unreachable);
+    }
+
+    return false;
+}
+
+// The colour and glyph columns of CELL_TYPE_TABLE
+#define CELL_COLOUR_ENTRY(code, flags, colour, glyph) [code] = colour,
+#define CELL_GLYPH_ENTRY(code, flags, colour, glyph) [code] = glyph,
+
+static const Color cellColours[CELL_TYPE_COUNT] = { CELL_TYPE_TABLE(CELL_COLOUR_ENTRY) };
+static const char* const cellGlyphs[CELL_TYPE_COUNT] = { CELL_TYPE_TABLE(CELL_GLYPH_ENTRY) };
+
+#undef CELL_COLOUR_ENTRY
+#undef CELL_GLYPH_ENTRY
+
+// Same colours as the main view, for the minimap
+Color GetCellColour(int cell)
+{
+    return cellColours[CELL_TYPE_INDEX(cell)];
+}
+
+// raylib's Fade, kept here so drawing into a recording backend doesn't need raylib linked in
+Color FadeColour(Color colour, float alpha)
+{
+    if (alpha < 0.0f)
     {
-        for (int x = 0; x < GRID_WIDTH; x++)
+        alpha = 0.0f;
+    }
+    else if (alpha > 1.0f)
+    {
+        alpha = 1.0f;
+    }
+
+    colour.a = (unsigned char)(255.0f * alpha);
+
+    return colour;
+}
+
+// Cells we've seen before but can't see right now are drawn with this much of their colour
+#define REMEMBERED_CELL_ALPHA 0.4f
+
+/* Our main print function.
+ * Only explored cells inside tiles (what the camera sees) are drawn, the rest of the floor stays a mystery!
+ * Everything is drawn in world space, call this between beginCamera and endCamera.
+ */
+void PrintDungeon(RenderBackend* render, const TileRect* tiles, const int grid[GRID_HEIGHT][GRID_WIDTH],
+                  const Room rooms[], int roomCount, const GridBits* explored, const GridBits* visible)
+{
+    TRACE_BEGIN(printZone, "PrintDungeon");
+
+    for (int y = tiles->minY; y <= tiles->maxY; y++)
+    {
+        bool rowExplored = false;
+
+        for (int word = tiles->minX >> 6; word <= tiles->maxX >> 6; word++)
+        {
+            rowExplored |= explored->rows[y][word] != 0;
+        }
+
+        if (!rowExplored)
         {
-            const int drawX = startX + (x * CELL_SIZE);
-            const int drawY = startY + (y * CELL_SIZE);
+            continue;
+        }
+
+        for (int x = tiles->minX; x <= tiles->maxX; x++)
+        {
+            if (!GET_GRID_BIT(explored, x, y))
+            {
+                continue;
+            }
+
+            const int drawX = x * CELL_SIZE;
+            const int drawY = y * CELL_SIZE;
             const int cell = grid[y][x];
+            const bool remembered = !GET_GRID_BIT(visible, x, y);
 
             if (IS_ROOM(cell))
             {
                 // Default room color
-                Color roomColor = BLACK;
+                Color roomColor = cellColours[ROOM_ID_START];
 
                 // Highlight special rooms
                 for (int i = 0; i < roomCount; i++)
@@ -139,40 +297,23 @@ void PrintDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount
                     }
                 }
 
-                DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, roomColor);
+                render->drawRectangle(render, drawX, drawY, CELL_SIZE, CELL_SIZE,
+                                      remembered ? FadeColour(roomColor, REMEMBERED_CELL_ALPHA) : roomColor);
             }
             else
             {
-                switch(cell)
-                {
-                    case CELL_EMPTY_1:
-                    case CELL_EMPTY_2:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, GRAY);
-                        break;
-
-                    case CELL_CORRIDOR:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, DARKGRAY);
-                        break;
+                const int type = CELL_TYPE_INDEX(cell);
 
-                    case CELL_DOOR:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, RED);
-                        break;
+                render->drawRectangle(render, drawX, drawY, CELL_SIZE, CELL_SIZE,
+                                      remembered ? FadeColour(cellColours[type], REMEMBERED_CELL_ALPHA) : cellColours[type]);
 
-                    case CELL_PATH:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, GREEN);
-                        break;
-
-                    case CELL_STAIR_UP:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, BLUE);
-                        DrawText("<", drawX + 5, drawY + 2, 12, WHITE);
-                        break;
-
-                    case CELL_STAIR_DOWN:
-                        DrawRectangle(drawX, drawY, CELL_SIZE, CELL_SIZE, PURPLE);
-                        DrawText(">", drawX + 5, drawY + 2, 12, WHITE);
-                        break;
+                if (cellGlyphs[type] != NULL)
+                {
+                    render->drawText(render, cellGlyphs[type], drawX + 5, drawY + 2, 12, WHITE);
                 }
             }
         }
     }
+
+    TRACE_END(printZone);
 }
\ No newline at end of file
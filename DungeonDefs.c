@@ -0,0 +1,12 @@
+﻿#include "DungeonDefs.h"
+
+/* The flags column of CELL_TYPE_TABLE, indexed by CELL_TYPE_INDEX(cell).
+ * Designated initializers, so unused codes are simply 0!
+ */
+#define CELL_FLAGS_ENTRY(code, flags, colour, glyph) [code] = (flags),
+
+const unsigned char cellFlags[CELL_TYPE_COUNT] = {
+    CELL_TYPE_TABLE(CELL_FLAGS_ENTRY)
+};
+
+#undef CELL_FLAGS_ENTRY
\ No newline at end of file
@@ -0,0 +1,269 @@
+﻿#include "EntityStore.h"
+#include <stdlib.h>
+#include "Log.h"
+
+// Big enough that it always lives on the heap, use DestroyEntityStore when done
+EntityStore* CreateEntityStore(void)
+{
+    EntityStore* store = malloc(sizeof(EntityStore));
+
+    if (store == NULL)
+    {
+        GAME_LOG_ERROR("Entity store allocation failed!");
+        return NULL;
+    }
+
+    ClearEntities(store);
+    return store;
+}
+
+void DestroyEntityStore(EntityStore* store)
+{
+    free(store);
+}
+
+// Called on every new floor, nothing follows the player down the stairs (yet!)
+void ClearEntities(EntityStore* store)
+{
+    store->highWater = 0;
+    store->liveCount = 0;
+    store->freeCount = 0;
+
+    for (int i = 0; i < GRID_SIZE; i++)
+    {
+        store->occupant[i] = ENTITY_NONE;
+        store->cellHead[i] = ENTITY_NONE;
+    }
+
+    ClearGridBits(&store->occupied);
+}
+
+// Newest entity first, the order within a cell doesn't matter to anyone
+static void LinkToCell(EntityStore* store, int entity)
+{
+    const int x = store->x[entity];
+    const int y = store->y[entity];
+    const int index = GET_GRID_INDEX(x, y);
+    const int head = store->cellHead[index];
+
+    store->cellPrev[entity] = ENTITY_NONE;
+    store->cellNext[entity] = head;
+
+    if (head != ENTITY_NONE)
+    {
+        store->cellPrev[head] = entity;
+    }
+
+    store->cellHead[index] = entity;
+    SET_GRID_BIT(&store->occupied, x, y);
+}
+
+static void UnlinkFromCell(EntityStore* store, int entity)
+{
+    const int x = store->x[entity];
+    const int y = store->y[entity];
+    const int index = GET_GRID_INDEX(x, y);
+    const int next = store->cellNext[entity];
+    const int prev = store->cellPrev[entity];
+
+    if (prev != ENTITY_NONE)
+    {
+        store->cellNext[prev] = next;
+    }
+    else
+    {
+        store->cellHead[index] = next;
+    }
+
+    if (next != ENTITY_NONE)
+    {
+        store->cellPrev[next] = prev;
+    }
+
+    if (store->cellHead[index] == ENTITY_NONE)
+    {
+        CLEAR_GRID_BIT(&store->occupied, x, y);
+    }
+}
+
+static bool BlocksCell(const EntityStore* store, int entity)
+{
+    return store->kind[entity] == ENTITY_MONSTER;
+}
+
+// Returns the new entity, or ENTITY_NONE when the store is full or a monster already stands there
+int SpawnEntity(EntityStore* store, EntityKind kind, int x, int y, int health)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return ENTITY_NONE;
+    }
+
+    if (kind == ENTITY_MONSTER && store->occupant[GET_GRID_INDEX(x, y)] != ENTITY_NONE)
+    {
+        return ENTITY_NONE;
+    }
+
+    int entity;
+
+    if (store->freeCount > 0)
+    {
+        entity = store->freeSlots[--store->freeCount];
+    }
+    else if (store->highWater < MAX_ENTITIES)
+    {
+        entity = store->highWater++;
+    }
+    else
+    {
+        GAME_LOG_WARN("Entity store is full (%d entities)", MAX_ENTITIES);
+        return ENTITY_NONE;
+    }
+
+    store->x[entity] = (int16_t)x;
+    store->y[entity] = (int16_t)y;
+    store->health[entity] = (int16_t)health;
+    store->energy[entity] = 0;
+    store->speed[entity] = 0;
+    store->kind[entity] = (uint8_t)kind;
+    store->aiState[entity] = AI_IDLE;
+    store->alive[entity] = 1;
+    store->liveCount++;
+
+    if (BlocksCell(store, entity))
+    {
+        store->occupant[GET_GRID_INDEX(x, y)] = entity;
+    }
+
+    LinkToCell(store, entity);
+
+    return entity;
+}
+
+void RemoveEntity(EntityStore* store, int entity)
+{
+    if (entity < 0 || entity >= store->highWater || !store->alive[entity])
+    {
+        return;
+    }
+
+    const int index = GET_GRID_INDEX(store->x[entity], store->y[entity]);
+
+    if (store->occupant[index] == entity)
+    {
+        store->occupant[index] = ENTITY_NONE;
+    }
+
+    UnlinkFromCell(store, entity);
+
+    store->alive[entity] = 0;
+    store->liveCount--;
+    store->freeSlots[store->freeCount++] = entity;
+}
+
+// Keeps the occupancy index in sync, fails when another monster is in the way
+bool MoveEntity(EntityStore* store, int entity, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return false;
+    }
+
+    const int newIndex = GET_GRID_INDEX(x, y);
+
+    if (BlocksCell(store, entity))
+    {
+        if (store->occupant[newIndex] != ENTITY_NONE)
+        {
+            return false;
+        }
+
+        store->occupant[GET_GRID_INDEX(store->x[entity], store->y[entity])] = ENTITY_NONE;
+        store->occupant[newIndex] = entity;
+    }
+
+    UnlinkFromCell(store, entity);
+
+    store->x[entity] = (int16_t)x;
+    store->y[entity] = (int16_t)y;
+
+    LinkToCell(store, entity);
+
+    return true;
+}
+
+int GetOccupant(const EntityStore* store, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return ENTITY_NONE;
+    }
+
+    return store->occupant[GET_GRID_INDEX(x, y)];
+}
+
+// Walk the rest of the cell with store->cellNext[entity] until ENTITY_NONE
+int GetFirstEntityAt(const EntityStore* store, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return ENTITY_NONE;
+    }
+
+    return store->cellHead[GET_GRID_INDEX(x, y)];
+}
+
+/* Every entity within radius of (x, y), a circle like the field of view.
+ * Only cells with their occupied bit set are looked at, and a row without any bits in range is skipped
+ * with a word test, so the cost is the rows of the box plus the entities actually found.
+ * Returns how many entities were written to results (at most maxResults).
+ */
+int QueryEntitiesInRadius(const EntityStore* store, int x, int y, int radius, int results[], int maxResults)
+{
+    const int minX = (x - radius < 0) ? 0 : x - radius;
+    const int maxX = (x + radius >= GRID_WIDTH) ? GRID_WIDTH - 1 : x + radius;
+    const int minY = (y - radius < 0) ? 0 : y - radius;
+    const int maxY = (y + radius >= GRID_HEIGHT) ? GRID_HEIGHT - 1 : y + radius;
+
+    int count = 0;
+
+    for (int cy = minY; cy <= maxY; cy++)
+    {
+        bool rowOccupied = false;
+
+        for (int word = minX >> 6; word <= maxX >> 6; word++)
+        {
+            rowOccupied |= store->occupied.rows[cy][word] != 0;
+        }
+
+        if (!rowOccupied)
+        {
+            continue;
+        }
+
+        const int dy = cy - y;
+
+        for (int cx = minX; cx <= maxX; cx++)
+        {
+            const int dx = cx - x;
+
+            if (!GET_GRID_BIT(&store->occupied, cx, cy) || dx * dx + dy * dy > radius * radius)
+            {
+                continue;
+            }
+
+            for (int entity = store->cellHead[GET_GRID_INDEX(cx, cy)]; entity != ENTITY_NONE;
+                 entity = store->cellNext[entity])
+            {
+                if (count == maxResults)
+                {
+                    return count;
+                }
+
+                results[count++] = entity;
+            }
+        }
+    }
+
+    return count;
+}
\ No newline at end of file
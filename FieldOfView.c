@@ -0,0 +1,109 @@
+﻿#include "FieldOfView.h"
+#include <stdbool.h>
+
+/* Symmetric shadowcasting!
+ *
+ * We look at the four quadrants (north, east, south, west) one at a time, row by row moving away from the origin.
+ * Each row only covers the cells between a start and an end slope, and a wall inside the row splits it:
+ * the part before the wall continues into the next row as its own scan, and the part after starts a new one.
+ * A floor cell is only visible when its centre lies inside the slopes, which makes sight symmetric,
+ * if we can see a cell, a monster standing there can see us too. Walls are visible as soon as any part is lit.
+ *
+ * Slopes are kept as exact fractions (numerator / denominator, denominator always positive),
+ * so there is no floating point rounding deciding what's visible.
+ */
+typedef struct FovScan {
+    const GridBits* opaque;
+    GridBits* visible;
+    int originX;
+    int originY;
+    int radius;
+    int quadrant;
+} FovScan;
+
+// Floor division, rounding towards negative infinity, divisor must be positive
+static int FloorDiv(int dividend, int divisor)
+{
+    return (dividend >= 0) ? dividend / divisor : -((-dividend + divisor - 1) / divisor);
+}
+
+// Row and column within the quadrant to grid coordinates
+static void TransformFovCell(const FovScan* scan, int depth, int col, int* x, int* y)
+{
+    switch (scan->quadrant)
+    {
+        case 0: *x = scan->originX + col;   *y = scan->originY - depth; break; // North
+        case 1: *x = scan->originX + depth; *y = scan->originY + col;   break; // East
+        case 2: *x = scan->originX + col;   *y = scan->originY + depth; break; // South
+        default: *x = scan->originX - depth; *y = scan->originY + col;  break; // West
+    }
+}
+
+static void ScanFovRow(const FovScan* scan, int depth, int startNum, int startDen, int endNum, int endDen)
+{
+    if (depth > scan->radius)
+    {
+        return;
+    }
+
+    // Round the slopes to columns, ties towards the middle of the row
+    const int minCol = FloorDiv(2 * depth * startNum + startDen, 2 * startDen);
+    const int maxCol = -FloorDiv(endDen - 2 * depth * endNum, 2 * endDen);
+
+    int previous = -1; // -1 nothing yet, 0 floor, 1 wall
+
+    for (int col = minCol; col <= maxCol; col++)
+    {
+        int x, y;
+        TransformFovCell(scan, depth, col, &x, &y);
+
+        const bool inGrid = IS_IN_GRID(x, y);
+        const bool wall = !inGrid || GET_GRID_BIT(scan->opaque, x, y);
+        const bool symmetric = col * startDen >= depth * startNum && col * endDen <= depth * endNum;
+
+        if (inGrid && (wall || symmetric) && col * col + depth * depth <= scan->radius * scan->radius)
+        {
+            SET_GRID_BIT(scan->visible, x, y);
+        }
+
+        if (previous == 1 && !wall)
+        {
+            // Coming out of a wall, the row now starts at this cell's left edge
+            startNum = 2 * col - 1;
+            startDen = 2 * depth;
+        }
+
+        if (previous == 0 && wall)
+        {
+            // Running into a wall, everything before it carries on in the next row
+            ScanFovRow(scan, depth + 1, startNum, startDen, 2 * col - 1, 2 * depth);
+        }
+
+        previous = wall ? 1 : 0;
+    }
+
+    if (previous == 0)
+    {
+        ScanFovRow(scan, depth + 1, startNum, startDen, endNum, endDen);
+    }
+}
+
+// Clears visible, then marks everything the origin can see within radius
+void ComputeFieldOfView(GridBits* visible, const GridBits* opaque, int originX, int originY, int radius)
+{
+    ClearGridBits(visible);
+
+    if (!IS_IN_GRID(originX, originY))
+    {
+        return;
+    }
+
+    SET_GRID_BIT(visible, originX, originY);
+
+    FovScan scan = { opaque, visible, originX, originY, radius, 0 };
+
+    for (scan.quadrant = 0; scan.quadrant < 4; scan.quadrant++)
+    {
+        ScanFovRow(&scan, 1, -1, 1, 1, 1);
+    }
+}
\ No newline at end of file
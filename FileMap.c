@@ -0,0 +1,117 @@
+﻿#include "FileMap.h"
+#include "Log.h"
+#include <string.h>
+
+/* NOTE: This file must never include raylib.h!
+ * windows.h declares CloseWindow, DrawText, Rectangle etc. which clash with raylib,
+ * so all platform specific code lives here on its own.
+ */
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+bool MapFileReadOnly(const char* path, MappedFile* file)
+{
+    memset(file, 0, sizeof(*file));
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        GAME_LOG_ERROR("Could not open %s for mapping!", path);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        GAME_LOG_ERROR("Could not map empty file %s!", path);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (mappingHandle == NULL)
+    {
+        GAME_LOG_ERROR("CreateFileMapping failed for %s!", path);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == NULL)
+    {
+        GAME_LOG_ERROR("MapViewOfFile failed for %s!", path);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    file->data = (const uint8_t*)view;
+    file->size = (size_t)fileSize.QuadPart;
+    file->fileHandle = fileHandle;
+    file->mappingHandle = mappingHandle;
+#else
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        GAME_LOG_ERROR("Could not open %s for mapping!", path);
+        return false;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        GAME_LOG_ERROR("Could not map empty file %s!", path);
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    // The mapping keeps its own reference, so we can close the descriptor right away
+    close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        GAME_LOG_ERROR("mmap failed for %s!", path);
+        return false;
+    }
+
+    file->data = (const uint8_t*)view;
+    file->size = (size_t)info.st_size;
+#endif
+
+    return true;
+}
+
+void UnmapFile(MappedFile* file)
+{
+    if (file->data == NULL)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(file->data);
+    CloseHandle((HANDLE)file->mappingHandle);
+    CloseHandle((HANDLE)file->fileHandle);
+#else
+    munmap((void*)file->data, file->size);
+#endif
+
+    memset(file, 0, sizeof(*file));
+}
\ No newline at end of file
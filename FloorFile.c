@@ -0,0 +1,358 @@
+﻿#include "FloorFile.h"
+#include "Log.h"
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(FloorFileHeader) == 16, "FloorFileHeader layout changed!");
+_Static_assert(sizeof(FloorRecordHeader) == 32, "FloorRecordHeader layout changed!");
+_Static_assert(sizeof(FloorRoomEntry) == 12, "FloorRoomEntry layout changed!");
+
+#define ALIGN_UP(value, alignment) (((value) + ((alignment) - 1)) & ~((size_t)(alignment) - 1))
+
+/* The worst case is a grid where no two neighbouring cells match,
+ * which gives us one (count, code) pair per cell!
+ */
+size_t GetFloorRecordBound(void)
+{
+    return ALIGN_UP(sizeof(FloorRecordHeader) + ROOM_AMOUNT * sizeof(FloorRoomEntry) + GRID_SIZE * 2,
+                    FLOOR_RECORD_ALIGNMENT);
+}
+
+/* Here, we squash the grid into runs of (count, cell code).
+ * Our dungeon has long stretches of the same cell (room interiors, the empty border),
+ * so this usually shrinks the grid to a small fraction of GRID_SIZE bytes.
+ *
+ * Returns the number of bytes written, or 0 if the floor can't be stored.
+ */
+size_t EncodeFloorRecord(uint8_t* buffer, size_t capacity, int grid[GRID_HEIGHT][GRID_WIDTH],
+                         Room rooms[], int roomCount, unsigned int seed, int floorNumber)
+{
+    if (roomCount < 0 || roomCount > ROOM_AMOUNT || capacity < GetFloorRecordBound())
+    {
+        return 0;
+    }
+
+    memset(buffer, 0, capacity);
+
+    FloorRecordHeader* header = (FloorRecordHeader*)buffer;
+    FloorRoomEntry* entries = (FloorRoomEntry*)(buffer + sizeof(FloorRecordHeader));
+    uint8_t* runs = (uint8_t*)(entries + roomCount);
+
+    header->seed = seed;
+    header->floorNumber = (uint16_t)floorNumber;
+    header->gridWidth = GRID_WIDTH;
+    header->gridHeight = GRID_HEIGHT;
+    header->roomCount = (uint16_t)roomCount;
+    header->stairUpX = header->stairUpY = FLOOR_NO_STAIR;
+    header->stairDownX = header->stairDownY = FLOOR_NO_STAIR;
+
+    for (int i = 0; i < roomCount; i++)
+    {
+        entries[i].x = (uint16_t)rooms[i].x;
+        entries[i].y = (uint16_t)rooms[i].y;
+        entries[i].width = (uint16_t)rooms[i].width;
+        entries[i].height = (uint16_t)rooms[i].height;
+        entries[i].type = (uint8_t)rooms[i].type;
+    }
+
+    const int* cells = &grid[0][0];
+
+    /* Empty cells alternate between CELL_EMPTY_1 and CELL_EMPTY_2 (see GenerateGrid),
+     * which is the worst possible input for RLE!
+     * If every empty cell still follows that pattern, we store them all as CELL_EMPTY_1,
+     * and the decoder simply puts the pattern back.
+     */
+    bool checkerEmpty = true;
+
+    for (int i = 0; i < GRID_SIZE && checkerEmpty; i++)
+    {
+        if (IS_EMPTY(cells[i]) && cells[i] != (((i % GRID_WIDTH) ^ (i / GRID_WIDTH)) & 1))
+        {
+            checkerEmpty = false;
+        }
+    }
+
+    header->flags = checkerEmpty ? FLOOR_FLAG_CHECKER_EMPTY : 0;
+
+    // Run-length encode the grid in row-major order
+    size_t runBytes = 0;
+    int runCode = (checkerEmpty && IS_EMPTY(cells[0])) ? CELL_EMPTY_1 : cells[0];
+    int runLength = 0;
+
+    for (int i = 0; i < GRID_SIZE; i++)
+    {
+        const int cell = (checkerEmpty && IS_EMPTY(cells[i])) ? CELL_EMPTY_1 : cells[i];
+
+        if (cell < 0 || cell > UINT8_MAX)
+        {
+            return 0; // Cell code doesn't fit in a byte!
+        }
+
+        if (cell == CELL_STAIR_UP)
+        {
+            header->stairUpX = (int16_t)(i % GRID_WIDTH);
+            header->stairUpY = (int16_t)(i / GRID_WIDTH);
+        }
+        else if (cell == CELL_STAIR_DOWN)
+        {
+            header->stairDownX = (int16_t)(i % GRID_WIDTH);
+            header->stairDownY = (int16_t)(i / GRID_WIDTH);
+        }
+
+        if (cell == runCode && runLength < UINT8_MAX)
+        {
+            runLength++;
+            continue;
+        }
+
+        runs[runBytes++] = (uint8_t)runLength;
+        runs[runBytes++] = (uint8_t)runCode;
+        runCode = cell;
+        runLength = 1;
+    }
+
+    runs[runBytes++] = (uint8_t)runLength;
+    runs[runBytes++] = (uint8_t)runCode;
+
+    header->runBytes = (uint32_t)runBytes;
+    header->recordSize = (uint32_t)ALIGN_UP((size_t)(runs + runBytes - buffer), FLOOR_RECORD_ALIGNMENT);
+
+    return header->recordSize;
+}
+
+/* Checks that a record fits in the given bytes and matches our grid, then points a view at it.
+ * This never copies anything, so it's safe to call for every lookup!
+ */
+bool GetFloorRecordView(const uint8_t* data, size_t size, FloorView* view)
+{
+    if (size < sizeof(FloorRecordHeader) || ((uintptr_t)data & (FLOOR_RECORD_ALIGNMENT - 1)) != 0)
+    {
+        return false;
+    }
+
+    const FloorRecordHeader* header = (const FloorRecordHeader*)data;
+    const size_t runsOffset = sizeof(FloorRecordHeader) + header->roomCount * sizeof(FloorRoomEntry);
+
+    if (header->recordSize > size ||
+        header->gridWidth != GRID_WIDTH || header->gridHeight != GRID_HEIGHT ||
+        header->roomCount > ROOM_AMOUNT ||
+        runsOffset + header->runBytes > header->recordSize)
+    {
+        return false;
+    }
+
+    view->header = header;
+    view->rooms = (const FloorRoomEntry*)(data + sizeof(FloorRecordHeader));
+    view->runs = data + runsOffset;
+
+    return true;
+}
+
+// Expands a view back into a playable grid and room table
+bool DecodeFloorView(FloorView view, int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount)
+{
+    int* cells = &grid[0][0];
+    int cellIndex = 0;
+
+    for (uint32_t i = 0; i + 1 < view.header->runBytes; i += 2)
+    {
+        const int runLength = view.runs[i];
+        const int runCode = view.runs[i + 1];
+
+        if (cellIndex + runLength > GRID_SIZE)
+        {
+            return false; // Corrupt record, too many cells!
+        }
+
+        for (int j = 0; j < runLength; j++)
+        {
+            cells[cellIndex++] = runCode;
+        }
+    }
+
+    if (cellIndex != GRID_SIZE)
+    {
+        return false;
+    }
+
+    if (view.header->flags & FLOOR_FLAG_CHECKER_EMPTY)
+    {
+        for (int y = 0; y < GRID_HEIGHT; y++)
+        {
+            for (int x = 0; x < GRID_WIDTH; x++)
+            {
+                if (IS_EMPTY(grid[y][x]))
+                {
+                    grid[y][x] = (x ^ y) & 1;
+                }
+            }
+        }
+    }
+
+    // The room table comes straight from the file, a stale or corrupt pack must not hand out rooms off the grid!
+    for (int i = 0; i < view.header->roomCount; i++)
+    {
+        const FloorRoomEntry* entry = &view.rooms[i];
+
+        if (entry->x + entry->width > GRID_WIDTH || entry->y + entry->height > GRID_HEIGHT ||
+            entry->type > ROOM_TYPE_BOSS)
+        {
+            return false;
+        }
+
+        rooms[i] = CreateRoom(entry->x, entry->y, entry->width, entry->height);
+        rooms[i].type = entry->type;
+    }
+
+    *roomCount = view.header->roomCount;
+
+    return true;
+}
+
+bool BeginFloorFile(FloorFileWriter* writer, const char* path, int maxFloors)
+{
+    memset(writer, 0, sizeof(*writer));
+
+    if (maxFloors <= 0)
+    {
+        return false;
+    }
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL)
+    {
+        GAME_LOG_ERROR("Could not create floor file %s!", path);
+        return false;
+    }
+
+    writer->offsetCapacity = (uint32_t)maxFloors;
+    writer->offsets = calloc(writer->offsetCapacity, sizeof(uint32_t));
+    writer->scratch = malloc(GetFloorRecordBound());
+
+    if (writer->offsets == NULL || writer->scratch == NULL)
+    {
+        GAME_LOG_ERROR("Floor writer allocation failed!");
+        fclose(writer->file);
+        free(writer->offsets);
+        free(writer->scratch);
+        memset(writer, 0, sizeof(*writer));
+        return false;
+    }
+
+    // Records start right after the header and the reserved offset table
+    writer->nextOffset = (uint32_t)ALIGN_UP(sizeof(FloorFileHeader) + writer->offsetCapacity * sizeof(uint32_t),
+                                            FLOOR_RECORD_ALIGNMENT);
+
+    if (fseek(writer->file, writer->nextOffset, SEEK_SET) != 0)
+    {
+        GAME_LOG_ERROR("Could not reserve the floor table in %s!", path);
+        fclose(writer->file);
+        free(writer->offsets);
+        free(writer->scratch);
+        memset(writer, 0, sizeof(*writer));
+        return false;
+    }
+
+    return true;
+}
+
+bool AppendFloor(FloorFileWriter* writer, int grid[GRID_HEIGHT][GRID_WIDTH],
+                 Room rooms[], int roomCount, unsigned int seed, int floorNumber)
+{
+    if (writer->floorCount >= writer->offsetCapacity)
+    {
+        GAME_LOG_ERROR("Floor file is full (%u floors)!", writer->offsetCapacity);
+        return false;
+    }
+
+    size_t size = EncodeFloorRecord(writer->scratch, GetFloorRecordBound(), grid, rooms, roomCount,
+                                    seed, floorNumber);
+
+    if (size == 0 || fwrite(writer->scratch, 1, size, writer->file) != size)
+    {
+        return false;
+    }
+
+    writer->offsets[writer->floorCount++] = writer->nextOffset;
+    writer->nextOffset += (uint32_t)size;
+
+    return true;
+}
+
+bool EndFloorFile(FloorFileWriter* writer)
+{
+    FloorFileHeader header = { 0 };
+    memcpy(header.magic, FLOOR_FILE_MAGIC, sizeof(header.magic));
+    header.version = FLOOR_FORMAT_VERSION;
+    header.recordAlignment = FLOOR_RECORD_ALIGNMENT;
+    header.floorCount = writer->floorCount;
+    header.offsetCapacity = writer->offsetCapacity;
+
+    bool success = fseek(writer->file, 0, SEEK_SET) == 0 &&
+                   fwrite(&header, sizeof(header), 1, writer->file) == 1 &&
+                   fwrite(writer->offsets, sizeof(uint32_t), writer->offsetCapacity, writer->file) ==
+                       writer->offsetCapacity;
+
+    success = (fclose(writer->file) == 0) && success;
+
+    free(writer->offsets);
+    free(writer->scratch);
+    memset(writer, 0, sizeof(*writer));
+
+    return success;
+}
+
+/* Opening only validates the header and the offset table bounds,
+ * individual records are checked when a view is requested.
+ * This keeps opening a file O(1) no matter how many floors it holds!
+ */
+bool OpenFloorFile(const char* path, FloorFile* floorFile)
+{
+    memset(floorFile, 0, sizeof(*floorFile));
+
+    if (!MapFileReadOnly(path, &floorFile->map))
+    {
+        return false;
+    }
+
+    const FloorFileHeader* header = (const FloorFileHeader*)floorFile->map.data;
+
+    if (floorFile->map.size < sizeof(FloorFileHeader) ||
+        memcmp(header->magic, FLOOR_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != FLOOR_FORMAT_VERSION ||
+        header->floorCount > header->offsetCapacity ||
+        sizeof(FloorFileHeader) + (size_t)header->offsetCapacity * sizeof(uint32_t) > floorFile->map.size)
+    {
+        GAME_LOG_ERROR("%s is not a valid floor file!", path);
+        UnmapFile(&floorFile->map);
+        return false;
+    }
+
+    floorFile->header = header;
+    floorFile->offsets = (const uint32_t*)(floorFile->map.data + sizeof(FloorFileHeader));
+
+    return true;
+}
+
+void CloseFloorFile(FloorFile* floorFile)
+{
+    UnmapFile(&floorFile->map);
+    memset(floorFile, 0, sizeof(*floorFile));
+}
+
+bool GetFloorView(const FloorFile* floorFile, int index, FloorView* view)
+{
+    if (floorFile->header == NULL || index < 0 || (uint32_t)index >= floorFile->header->floorCount)
+    {
+        return false;
+    }
+
+    const uint32_t offset = floorFile->offsets[index];
+
+    if (offset >= floorFile->map.size)
+    {
+        return false;
+    }
+
+    return GetFloorRecordView(floorFile->map.data + offset, floorFile->map.size - offset, view);
+}
\ No newline at end of file
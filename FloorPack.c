@@ -0,0 +1,226 @@
+﻿#include "FloorPack.h"
+#include "Log.h"
+#include <stdlib.h>
+#include <string.h>
+
+_Static_assert(sizeof(FloorPackHeader) == 24, "FloorPackHeader layout changed!");
+_Static_assert(sizeof(FloorPackEntry) == 24, "FloorPackEntry layout changed!");
+
+bool BeginFloorPack(FloorPackWriter* writer, const char* path, int maxFloors)
+{
+    memset(writer, 0, sizeof(*writer));
+
+    if (maxFloors <= 0)
+    {
+        return false;
+    }
+
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL)
+    {
+        GAME_LOG_ERROR("Could not create floor pack %s!", path);
+        return false;
+    }
+
+    writer->capacity = (uint32_t)maxFloors;
+    writer->entries = malloc(writer->capacity * sizeof(FloorPackEntry));
+    writer->scratch = malloc(GetFloorRecordBound());
+
+    if (writer->entries == NULL || writer->scratch == NULL)
+    {
+        GAME_LOG_ERROR("Floor pack writer allocation failed!");
+        fclose(writer->file);
+        free(writer->entries);
+        free(writer->scratch);
+        memset(writer, 0, sizeof(*writer));
+        return false;
+    }
+
+    // Placeholder header, the real one is written by EndFloorPack
+    FloorPackHeader header = { 0 };
+
+    if (fwrite(&header, sizeof(header), 1, writer->file) != 1)
+    {
+        GAME_LOG_ERROR("Could not write floor pack header!");
+        fclose(writer->file);
+        free(writer->entries);
+        free(writer->scratch);
+        memset(writer, 0, sizeof(*writer));
+        return false;
+    }
+
+    writer->nextOffset = sizeof(FloorPackHeader); // Already a multiple of FLOOR_RECORD_ALIGNMENT
+
+    return true;
+}
+
+bool AddFloorToPack(FloorPackWriter* writer, int grid[GRID_HEIGHT][GRID_WIDTH],
+                    Room rooms[], int roomCount, unsigned int seed, int floorNumber)
+{
+    if (writer->floorCount >= writer->capacity)
+    {
+        GAME_LOG_ERROR("Floor pack is full (%u floors)!", writer->capacity);
+        return false;
+    }
+
+    if (floorNumber <= 0 || floorNumber > UINT16_MAX)
+    {
+        GAME_LOG_ERROR("Floor number %d doesn't fit in a floor pack!", floorNumber);
+        return false;
+    }
+
+    size_t size = EncodeFloorRecord(writer->scratch, GetFloorRecordBound(), grid, rooms, roomCount,
+                                    seed, floorNumber);
+
+    if (size == 0 || fwrite(writer->scratch, 1, size, writer->file) != size)
+    {
+        return false;
+    }
+
+    FloorPackEntry* entry = &writer->entries[writer->floorCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->seed = seed;
+    entry->floorNumber = (uint16_t)floorNumber;
+    entry->recordSize = (uint32_t)size;
+    entry->offset = writer->nextOffset;
+
+    writer->nextOffset += size;
+
+    return true;
+}
+
+// The index key, seed first and the floor number breaks ties
+static int CompareEntryKey(const FloorPackEntry* entry, uint32_t seed, uint16_t floorNumber)
+{
+    if (entry->seed != seed)
+    {
+        return (entry->seed > seed) - (entry->seed < seed);
+    }
+
+    return (entry->floorNumber > floorNumber) - (entry->floorNumber < floorNumber);
+}
+
+static int CompareEntries(const void* a, const void* b)
+{
+    const FloorPackEntry* entryB = (const FloorPackEntry*)b;
+
+    return CompareEntryKey((const FloorPackEntry*)a, entryB->seed, entryB->floorNumber);
+}
+
+/* Here, we sort the index by (seed, floor number) and write it after the records.
+ * If the same floor was added twice, we only keep the first one,
+ * otherwise the binary search could land on either of them!
+ */
+bool EndFloorPack(FloorPackWriter* writer)
+{
+    qsort(writer->entries, writer->floorCount, sizeof(FloorPackEntry), CompareEntries);
+
+    uint32_t uniqueCount = 0;
+
+    for (uint32_t i = 0; i < writer->floorCount; i++)
+    {
+        if (uniqueCount == 0 || CompareEntries(&writer->entries[uniqueCount - 1], &writer->entries[i]) != 0)
+        {
+            writer->entries[uniqueCount++] = writer->entries[i];
+        }
+    }
+
+    FloorPackHeader header = { 0 };
+    memcpy(header.magic, FLOOR_PACK_MAGIC, sizeof(header.magic));
+    header.version = FLOOR_PACK_VERSION;
+    header.recordAlignment = FLOOR_RECORD_ALIGNMENT;
+    header.floorCount = uniqueCount;
+    header.indexOffset = writer->nextOffset;
+
+    bool success = fwrite(writer->entries, sizeof(FloorPackEntry), uniqueCount, writer->file) == uniqueCount &&
+                   fseek(writer->file, 0, SEEK_SET) == 0 &&
+                   fwrite(&header, sizeof(header), 1, writer->file) == 1;
+
+    success = (fclose(writer->file) == 0) && success;
+
+    free(writer->entries);
+    free(writer->scratch);
+    memset(writer, 0, sizeof(*writer));
+
+    return success;
+}
+
+bool OpenFloorPack(const char* path, FloorPack* pack)
+{
+    memset(pack, 0, sizeof(*pack));
+
+    if (!MapFileReadOnly(path, &pack->map))
+    {
+        return false;
+    }
+
+    const FloorPackHeader* header = (const FloorPackHeader*)pack->map.data;
+
+    if (pack->map.size < sizeof(FloorPackHeader) ||
+        memcmp(header->magic, FLOOR_PACK_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != FLOOR_PACK_VERSION ||
+        header->indexOffset > pack->map.size ||
+        (pack->map.size - header->indexOffset) / sizeof(FloorPackEntry) < header->floorCount)
+    {
+        GAME_LOG_ERROR("%s is not a valid floor pack!", path);
+        UnmapFile(&pack->map);
+        return false;
+    }
+
+    pack->header = header;
+    pack->index = (const FloorPackEntry*)(pack->map.data + header->indexOffset);
+
+    return true;
+}
+
+void CloseFloorPack(FloorPack* pack)
+{
+    UnmapFile(&pack->map);
+    memset(pack, 0, sizeof(*pack));
+}
+
+/* Binary search over the sorted (seed, floor number) index.
+ * Only ~log2(n) index entries and the one record we want are ever paged in,
+ * so a pack of millions of floors costs about the same as a pack of ten!
+ */
+bool FindPackedFloor(const FloorPack* pack, unsigned int seed, int floorNumber, FloorView* view)
+{
+    if (pack->header == NULL || floorNumber <= 0 || floorNumber > UINT16_MAX)
+    {
+        return false;
+    }
+
+    uint32_t low = 0;
+    uint32_t high = pack->header->floorCount;
+
+    while (low < high)
+    {
+        const uint32_t middle = low + ((high - low) >> 1);
+
+        if (CompareEntryKey(&pack->index[middle], seed, (uint16_t)floorNumber) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if (low == pack->header->floorCount || CompareEntryKey(&pack->index[low], seed, (uint16_t)floorNumber) != 0)
+    {
+        return false;
+    }
+
+    const FloorPackEntry* entry = &pack->index[low];
+
+    // Records always sit between the header and the index
+    if (entry->offset < sizeof(FloorPackHeader) ||
+        entry->offset + entry->recordSize > pack->header->indexOffset)
+    {
+        return false;
+    }
+
+    return GetFloorRecordView(pack->map.data + entry->offset, entry->recordSize, view) &&
+           view->header->seed == seed && view->header->floorNumber == floorNumber;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+﻿#include "FloorValidator.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include "GridBits.h"
+#include "Log.h"
+
+_Static_assert(ROOM_AMOUNT <= 30, "Room bits would collide with the FLOOR_UNREACHABLE_* flags!");
+
+// The player starts on the up staircase, or in the middle of the start room on the first floor
+static bool FindStartCell(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount, int* startX, int* startY)
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (grid[y][x] == CELL_STAIR_UP)
+            {
+                *startX = x;
+                *startY = y;
+                return true;
+            }
+        }
+    }
+
+    for (int i = 0; i < roomCount; i++)
+    {
+        if (rooms[i].type == ROOM_TYPE_START)
+        {
+            GetRoomCenter(rooms[i], startX, startY);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Our floor validator!
+ * Rather than trusting the generators' own bookkeeping, we look at the grid exactly like the player does:
+ * one flood fill over the walkable mask from the start, with diagonal steps since the player can take those too.
+ * Then every room, door and the down staircase simply has to have been reached.
+ *
+ * Each cell is queued at most once, so this is linear in the grid size and cheap enough for every floor!
+ */
+uint32_t ValidateFloorConnectivity(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount)
+{
+    const uint32_t allRooms = (roomCount >= 32) ? UINT32_MAX : ((1u << roomCount) - 1u);
+    const uint32_t everything = allRooms | FLOOR_UNREACHABLE_DOOR | FLOOR_UNREACHABLE_STAIR_DOWN;
+
+    // Same walkability as IsValidPlayerPosition, and both bitsets fit comfortably on the stack
+    FloorMasks masks;
+    GridBits reached;
+
+    BuildFloorMasks(&masks, grid);
+    ClearGridBits(&reached);
+
+    int startX, startY;
+
+    if (!FindStartCell(grid, rooms, roomCount, &startX, &startY) || !IsWalkable(&masks, startX, startY))
+    {
+        GAME_LOG_WARN("Floor has no walkable start cell!");
+        return everything;
+    }
+
+    int* queue = malloc(GRID_SIZE * sizeof(int));
+
+    if (queue == NULL)
+    {
+        GAME_LOG_ERROR("Floor validator allocation failed!");
+        return everything;
+    }
+
+    int queueFront = 0;
+    int queueBack = 0;
+
+    queue[queueBack++] = GET_GRID_INDEX(startX, startY);
+    SET_GRID_BIT(&reached, startX, startY);
+
+    while (queueFront < queueBack)
+    {
+        const int index = queue[queueFront++];
+        const int x = index % GRID_WIDTH;
+        const int y = index / GRID_WIDTH;
+
+        for (int dy = -1; dy <= 1; dy++)
+        {
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                const int newX = x + dx;
+                const int newY = y + dy;
+
+                if (!IS_IN_GRID(newX, newY) || GET_GRID_BIT(&reached, newX, newY) ||
+                    !GET_GRID_BIT(&masks.walkable, newX, newY))
+                {
+                    continue;
+                }
+
+                SET_GRID_BIT(&reached, newX, newY);
+                queue[queueBack++] = GET_GRID_INDEX(newX, newY);
+            }
+        }
+    }
+
+    uint32_t unreachable = FLOOR_REACHABLE;
+
+    // Rooms are solid rectangles, so reaching any one of their cells means reaching all of them
+    for (int i = 0; i < roomCount; i++)
+    {
+        if (!GET_GRID_BIT(&reached, rooms[i].x, rooms[i].y))
+        {
+            unreachable |= 1u << i;
+        }
+    }
+
+    bool foundStairDown = false;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (grid[y][x] == CELL_DOOR && !GET_GRID_BIT(&reached, x, y))
+            {
+                unreachable |= FLOOR_UNREACHABLE_DOOR;
+            }
+            else if (grid[y][x] == CELL_STAIR_DOWN)
+            {
+                foundStairDown = true;
+
+                if (!GET_GRID_BIT(&reached, x, y))
+                {
+                    unreachable |= FLOOR_UNREACHABLE_STAIR_DOWN;
+                }
+            }
+        }
+    }
+
+    if (!foundStairDown)
+    {
+        unreachable |= FLOOR_UNREACHABLE_STAIR_DOWN;
+    }
+
+    free(queue);
+
+    return unreachable;
+}
\ No newline at end of file
@@ -1,10 +1,25 @@
-﻿#include "Raylib.h"
+﻿#include <raylib.h>
 #include "Game.h"
 
 #include <stdio.h>
 #include <string.h>
+#include "Log.h"
 
 #include "Dungeon.h"
+#include "FloorValidator.h"
+#include "Random.h"
+#include "Trace.h"
+
+// Floor population
+#define MAX_MONSTERS_PER_ROOM 3
+#define MAX_ITEMS_PER_ROOM 1
+#define MONSTER_BASE_HEALTH 3
+#define MONSTER_MIN_SPEED 5
+#define MONSTER_MAX_SPEED 15
+#define POPULATION_SEED_SALT 0x9E3779B9u
+
+// Travel interruption, monsters past this many in view aren't looked at
+#define MAX_MONSTERS_IN_VIEW 64
 
 Game InitGame(int width, int height)
 {
@@ -15,68 +30,299 @@ Game InitGame(int width, int height)
         .grid = {0}, // default initialization
         .generationAttempts = 0,
         .currentFloor = 1,  // Starting floor!
+        .floorSeed = 0,
+        .floorPack = NULL,
+        .challengeSeed = 0,
         .playerPos = {0, 0},
         .transitioningFloors = false,
-        .turnCounter = 0
+        .turnCounter = 0,
+        .zoom = CAMERA_ZOOM_DEFAULT
     };
 
+    StopTravel(&game.travel);
+
     // placeholder player
     game.player = InitPlayer(0, 0, CELL_SIZE / 2, CELL_SIZE / 2, YELLOW);
 
+    // Far too big for the stack, UnloadGame frees it
+    game.entities = CreateEntityStore();
+    game.scheduler = CreateTurnScheduler();
+    game.ai = CreateMonsterAi();
+    game.minimap = CreateMinimap();
+
     return game;
 }
 
-bool GenerateFloor(Game* game)
+void UnloadGame(Game* game)
 {
-    const int MAX_GENERATION_ATTEMPTS = 5;
-    game->generationAttempts = 0;
+    DestroyEntityStore(game->entities);
+    DestroyTurnScheduler(game->scheduler);
+    DestroyMonsterAi(game->ai);
+    DestroyMinimap(game->minimap);
+    game->minimap = NULL;
+    game->entities = NULL;
+    game->scheduler = NULL;
+    game->ai = NULL;
+}
+
+/* Floor packs are just a cache of GenerateSeededDungeon,
+ * so a pack miss (or a record for a different floor number) falls back to generating the same floor!
+ */
+static bool LoadFloorFromPack(Game* game)
+{
+    FloorView view;
+
+    if (game->floorPack == NULL ||
+        !FindPackedFloor(game->floorPack, game->floorSeed, game->currentFloor, &view))
+    {
+        return false;
+    }
+
+    if (!DecodeFloorView(view, game->grid, game->rooms, &game->roomCount))
+    {
+        return false;
+    }
 
-    while (game->generationAttempts < MAX_GENERATION_ATTEMPTS)
+    // Packs can be older than the generator, never hand the player a broken floor
+    const uint32_t unreachable = ValidateFloorConnectivity(game->grid, game->rooms, game->roomCount);
+
+    if (unreachable != FLOOR_REACHABLE)
     {
-        game->generationAttempts++;
+        GAME_LOG_WARN("Packed floor for seed %u failed validation (unreachable 0x%08x), regenerating",
+                      game->floorSeed, unreachable);
+        return false;
+    }
+
+    return true;
+}
 
-        // Clear the grid for fresh generation
-        memset(game->grid, 0, sizeof(game->grid));
+// What the player sees from where they stand, and everything seen stays explored
+static void UpdatePlayerView(Game* game)
+{
+    ComputeFieldOfView(&game->visible, &game->masks.opaque, game->playerPos.x, game->playerPos.y, FOV_RADIUS);
+    OrGridBits(&game->explored, &game->visible);
 
-        if (GenerateDungeon(game->grid, MAX_GENERATION_ATTEMPTS, game->currentFloor,
-                            game->rooms, &game->roomCount))
+    if (game->minimap != NULL)
+    {
+        const TileRect sight =
         {
-            printf("Floor %d generated successfully on attempt %d\n",
-                   game->currentFloor, game->generationAttempts);
+            (game->playerPos.x - FOV_RADIUS < 0) ? 0 : game->playerPos.x - FOV_RADIUS,
+            (game->playerPos.y - FOV_RADIUS < 0) ? 0 : game->playerPos.y - FOV_RADIUS,
+            (game->playerPos.x + FOV_RADIUS >= GRID_WIDTH) ? GRID_WIDTH - 1 : game->playerPos.x + FOV_RADIUS,
+            (game->playerPos.y + FOV_RADIUS >= GRID_HEIGHT) ? GRID_HEIGHT - 1 : game->playerPos.y + FOV_RADIUS
+        };
 
-            // Find player start position (should be in the start room)
-            for (int i = 0; i < game->roomCount; i++)
-            {
-                if (game->rooms[i].type == ROOM_TYPE_START)
-                {
-                    game->playerPos.x = game->rooms[i].x + (game->rooms[i].width / 2);
-                    game->playerPos.y = game->rooms[i].y + (game->rooms[i].height / 2);
+        UpdateMinimap(game->minimap, game->grid, &game->explored, &sight);
+    }
+}
 
-                    // Set player's internal position
-                    game->player.x = game->playerPos.x;
-                    game->player.y = game->playerPos.y;
+// The stairs never move, so their maps are built once per floor
+static void BuildStairDistances(Game* game)
+{
+    ClearDistanceMap(&game->stairUpDistances);
+    ClearDistanceMap(&game->stairDownDistances);
 
-                    return true;
-                }
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (game->grid[y][x] == CELL_STAIR_UP)
+            {
+                BuildDistanceMap(&game->stairUpDistances, &game->masks, x, y);
             }
-
-            // Fallback position if no start room was found
-            if (game->roomCount > 0)
+            else if (game->grid[y][x] == CELL_STAIR_DOWN)
             {
-                game->playerPos.x = game->rooms[0].x + (game->rooms[0].width / 2);
-                game->playerPos.y = game->rooms[0].y + (game->rooms[0].height / 2);
+                BuildDistanceMap(&game->stairDownDistances, &game->masks, x, y);
+            }
+        }
+    }
+}
+
+/* Every room except the one the player starts in gets a few monsters and maybe an item.
+ * We reseed from the floor seed first, so the same floor seed always gets the same monsters,
+ * whether the floor was generated or came out of a floor pack (replays rely on that)!
+ */
+static void PopulateFloor(Game* game)
+{
+    if (game->entities == NULL)
+    {
+        return;
+    }
+
+    ClearEntities(game->entities);
+    SeedRandom(game->floorSeed ^ POPULATION_SEED_SALT);
+
+    for (int i = 0; i < game->roomCount; i++)
+    {
+        const Room room = game->rooms[i];
+        const bool playerInRoom = game->playerPos.x >= room.x && game->playerPos.x < room.x + room.width &&
+                                  game->playerPos.y >= room.y && game->playerPos.y < room.y + room.height;
+
+        if (room.type == ROOM_TYPE_START || playerInRoom)
+        {
+            continue;
+        }
 
-                // Set player's internal position
-                game->player.x = game->playerPos.x;
-                game->player.y = game->playerPos.y;
+        const int monsterCount = GetRandomInt(0, MAX_MONSTERS_PER_ROOM);
+        const int itemCount = GetRandomInt(0, MAX_ITEMS_PER_ROOM);
 
-                return true;
+        for (int m = 0; m < monsterCount; m++)
+        {
+            // A taken cell just means one monster less
+            const int monster = SpawnEntity(game->entities, ENTITY_MONSTER,
+                                            GetRandomInt(room.x, room.x + room.width - 1),
+                                            GetRandomInt(room.y, room.y + room.height - 1),
+                                            MONSTER_BASE_HEALTH + game->currentFloor);
+
+            if (monster != ENTITY_NONE)
+            {
+                game->entities->speed[monster] = (uint8_t)GetRandomInt(MONSTER_MIN_SPEED, MONSTER_MAX_SPEED);
             }
         }
+
+        for (int n = 0; n < itemCount; n++)
+        {
+            SpawnEntity(game->entities, ENTITY_ITEM,
+                        GetRandomInt(room.x, room.x + room.width - 1),
+                        GetRandomInt(room.y, room.y + room.height - 1), 1);
+        }
+    }
+
+    GAME_LOG_DEBUG("Floor %d populated with %d entities", game->currentFloor, game->entities->liveCount);
+}
+
+/* The player goes first on a new floor, every monster gets a random head start within its first turn
+ * so they don't all move in lockstep.
+ */
+static void ScheduleFloorActors(Game* game)
+{
+    if (game->scheduler == NULL || game->entities == NULL)
+    {
+        return;
+    }
+
+    ClearScheduler(game->scheduler);
+
+    game->player.energy = ACTION_ENERGY;
+    ScheduleActor(game->scheduler, ACTOR_PLAYER, 0);
+
+    const EntityStore* store = game->entities;
+
+    for (int i = 0; i < store->highWater; i++)
+    {
+        if (store->alive[i] && store->speed[i] > 0)
+        {
+            game->entities->energy[i] = ACTION_ENERGY;
+            ScheduleActor(game->scheduler, i, GetRandomInt(0, ACTION_ENERGY / store->speed[i]));
+        }
+    }
+}
+
+// The player is in place, now everything that depends on where they stand
+static void EnterFloor(Game* game)
+{
+    BuildDistanceMap(&game->playerDistances, &game->masks, game->playerPos.x, game->playerPos.y);
+    UpdatePlayerView(game);
+    PopulateFloor(game);
+    ScheduleFloorActors(game);
+}
+
+bool GenerateFloor(Game* game)
+{
+    const int MAX_GENERATION_ATTEMPTS = 5;
+    game->generationAttempts = 0;
+
+    /* Every floor gets its own seed, which we then feed back into the generator.
+     * That way the exact same floor (retries included) can be regenerated or saved later!
+     *
+     * Challenge runs (with a floor pack) use fixed seeds instead, so everyone plays the same floors.
+     */
+    if (game->floorPack != NULL)
+    {
+        game->floorSeed = CHALLENGE_FLOOR_SEED(game->challengeSeed, game->currentFloor);
+    }
+    else
+    {
+        game->floorSeed = ((unsigned int)GetRandomInt(0, 0xFFFF) << 16) | (unsigned int)GetRandomInt(0, 0xFFFF);
+    }
+
+    // Replays play the recorded seeds back instead, the floor pack doesn't matter then
+    if (game->replay != NULL && game->replay->mode == REPLAY_RECORDING)
+    {
+        RecordReplaySeed(game->replay, game->floorSeed);
+    }
+    else if (game->replay != NULL && !ReadReplaySeed(game->replay, &game->floorSeed))
+    {
+        GAME_LOG_WARN("Replay ran out of floor seeds, using seed %u", game->floorSeed);
+    }
+
+    if (LoadFloorFromPack(game))
+    {
+        memset(&game->generationStats, 0, sizeof(game->generationStats)); // Nothing was generated!
+        GAME_LOG_INFO("Floor %d loaded from floor pack (seed %u)", game->currentFloor, game->floorSeed);
+    }
+    else if (GenerateSeededDungeon(game->grid, game->floorSeed, MAX_GENERATION_ATTEMPTS, game->currentFloor,
+                                   game->rooms, &game->roomCount, &game->generationAttempts,
+                                   &game->generationStats))
+    {
+        GAME_LOG_INFO("Floor %d generated successfully on attempt %d",
+                      game->currentFloor, game->generationAttempts);
+        GAME_LOG_DEBUG("Rooms: %lld attempts, %lld rejected | Mazes: %lld seeds, %lld cells | Doors: %lld probes, %lld fallbacks",
+                       game->generationStats.roomPlacementAttempts, game->generationStats.roomPlacementRejections,
+                       game->generationStats.mazeFloodFillSeeds, game->generationStats.corridorCellsCarved,
+                       game->generationStats.doorCorridorProbes, game->generationStats.doorFallbackPlacements);
+        GAME_LOG_DEBUG("Paths: %lld searches, %lld nodes expanded, %lld escalations, %lld cells placed",
+                       game->generationStats.pathSearches, game->generationStats.pathNodesExpanded,
+                       game->generationStats.pathFallbackEscalations, game->generationStats.pathCellsPlaced);
+    }
+    else
+    {
+        GAME_LOG_ERROR("Failed to generate floor %d after %d attempts",
+                       game->currentFloor, MAX_GENERATION_ATTEMPTS);
+
+        return false;
+    }
+
+    BuildFloorMasks(&game->masks, game->grid);
+    BuildStairDistances(game);
+    ClearGridBits(&game->explored);
+    StopTravel(&game->travel);
+
+    if (game->minimap != NULL)
+    {
+        ResetMinimap(game->minimap);
+    }
+
+    // Find player start position (should be in the start room)
+    for (int i = 0; i < game->roomCount; i++)
+    {
+        if (game->rooms[i].type == ROOM_TYPE_START)
+        {
+            game->playerPos.x = game->rooms[i].x + (game->rooms[i].width / 2);
+            game->playerPos.y = game->rooms[i].y + (game->rooms[i].height / 2);
+
+            // Set player's internal position
+            game->player.x = game->playerPos.x;
+            game->player.y = game->playerPos.y;
+
+            EnterFloor(game);
+            return true;
+        }
     }
 
-    printf("Failed to generate floor %d after %d attempts\n",
-           game->currentFloor, MAX_GENERATION_ATTEMPTS);
+    // Fallback position if no start room was found
+    if (game->roomCount > 0)
+    {
+        game->playerPos.x = game->rooms[0].x + (game->rooms[0].width / 2);
+        game->playerPos.y = game->rooms[0].y + (game->rooms[0].height / 2);
+
+        // Set player's internal position
+        game->player.x = game->playerPos.x;
+        game->player.y = game->playerPos.y;
+
+        EnterFloor(game);
+        return true;
+    }
 
     return false;
 }
@@ -86,7 +332,7 @@ void GoDownStairs(Game* game)
     game->currentFloor++;
     game->transitioningFloors = true;
 
-    printf("Going down to floor %d\n", game->currentFloor);
+    GAME_LOG_INFO("Going down to floor %d", game->currentFloor);
 }
 
 void GoUpStairs(Game* game)
@@ -96,104 +342,392 @@ void GoUpStairs(Game* game)
         game->currentFloor--;
         game->transitioningFloors = true;
 
-        printf("Going up to floor %d\n", game->currentFloor);
+        GAME_LOG_INFO("Going up to floor %d", game->currentFloor);
     }
     else
     {
-        printf("Already on the top floor!\n");
+        GAME_LOG_INFO("Already on the top floor!");
     }
 }
 
-void UpdateGame(Game* game)
+/* The player just acted, so they go to the back of the schedule,
+ * then every monster due before the player's next turn takes its turn. The player is always
+ * at the front of the schedule while we wait for input!
+ */
+static void EndPlayerTurn(Game* game)
 {
-    if (IsKeyPressed(KEY_G))
+    TurnScheduler* scheduler = game->scheduler;
+
+    if (scheduler == NULL || game->entities == NULL || game->ai == NULL)
     {
-        printf("Regenerating dungeon...\n");
-        game->transitioningFloors = true;
         return;
     }
 
+    ScheduleActor(scheduler, ACTOR_PLAYER, SpendActionEnergy(&game->player.energy, game->player.speed));
+
+    // The player stands still until their next turn, so every monster can share the same maps
+    UpdateMonsterStates(game->ai, game->entities, &game->playerDistances);
+
+    if (game->ai->fleeingCount > 0)
+    {
+        BuildFleeMap(game->ai, &game->playerDistances, &game->masks);
+    }
+
+    int actor;
+
+    // Peek first, so the player stays in the schedule once it's their turn again
+    while ((actor = PeekNextActor(scheduler)) != ACTOR_PLAYER && actor != ACTOR_NONE)
+    {
+        PopNextActor(scheduler);
+
+        if (!game->entities->alive[actor])
+        {
+            continue;
+        }
+
+        StepMonster(game->ai, game->entities, actor, &game->playerDistances, &game->masks,
+                    game->playerPos.x, game->playerPos.y);
+
+        EntityStore* store = game->entities;
+        ScheduleActor(scheduler, actor, SpendActionEnergy(&store->energy[actor], store->speed[actor]));
+    }
+}
+
+// Everything that happens when the player steps onto a new cell, one turn each
+static void MovePlayer(Game* game, int x, int y)
+{
+    game->turnCounter++;
+
+    UpdatePlayerPosition(&game->player, x, y);
+    game->playerPos.x = x;
+    game->playerPos.y = y;
+
+    MoveDistanceMapSource(&game->playerDistances, &game->masks, x, y);
+    UpdatePlayerView(game);
+
+    EndPlayerTurn(game);
+}
+
+/* A radius query on the entity store, then the visible bits decide.
+ * Only hunting monsters count, an idle one in the corner of the room shouldn't stop every click!
+ */
+static bool IsHunterInView(const Game* game)
+{
+    int nearby[MAX_MONSTERS_IN_VIEW];
+    const int count = QueryEntitiesInRadius(game->entities, game->playerPos.x, game->playerPos.y,
+                                            FOV_RADIUS, nearby, MAX_MONSTERS_IN_VIEW);
+
+    for (int i = 0; i < count; i++)
+    {
+        const int entity = nearby[i];
+
+        if (game->entities->kind[entity] == ENTITY_MONSTER && game->entities->aiState[entity] == AI_HUNTING &&
+            GET_GRID_BIT(&game->visible, game->entities->x[entity], game->entities->y[entity]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void RunTravel(Game* game)
+{
+    for (int i = 0; i < TRAVEL_STEPS_PER_UPDATE; i++)
+    {
+        int stepX, stepY;
+
+        if (IsHunterInView(game))
+        {
+            GAME_LOG_INFO("Travel interrupted, something is coming for you!");
+            StopTravel(&game->travel);
+            return;
+        }
+
+        if (!NextTravelStep(&game->travel, &game->masks, &game->explored,
+                            game->playerPos.x, game->playerPos.y, &stepX, &stepY))
+        {
+            GAME_LOG_DEBUG("Travel finished at (%d,%d) - Turn: %d",
+                           game->playerPos.x, game->playerPos.y, game->turnCounter);
+            return;
+        }
+
+        // The field only knows about walls, a monster standing in the way ends the trip
+        if (!IsValidPlayerPosition(&game->masks, game->entities, stepX, stepY))
+        {
+            GAME_LOG_DEBUG("Travel blocked at (%d,%d)", stepX, stepY);
+            StopTravel(&game->travel);
+            return;
+        }
+
+        MovePlayer(game, stepX, stepY);
+    }
+}
+
+// Whether an empty frame still does something, generating a floor or taking travel steps
+bool IsGameBusy(const Game* game)
+{
+    return !game->dungeonGenerated || game->transitioningFloors || game->travel.mode != TRAVEL_NONE;
+}
+
+// Where the session stands, a replay has to end up in the exact same spot
+ReplayCheckpoint GetGameCheckpoint(const Game* game)
+{
+    const ReplayCheckpoint checkpoint =
+    {
+        (uint32_t)game->turnCounter,
+        (uint32_t)game->currentFloor,
+        (uint32_t)game->playerPos.x,
+        (uint32_t)game->playerPos.y
+    };
+
+    return checkpoint;
+}
+
+/* Returns true when anything on screen changed, so the caller can skip redrawing a floor that looks the same.
+ * Every move and stair step bumps turnCounter, the rest (zoom, trace, floor changes) says so itself.
+ */
+bool UpdateGame(Game* game, GameInput input)
+{
+    const int turnBefore = game->turnCounter;
+    bool changed = false;
+
+    if (game->replay != NULL && game->replay->mode == REPLAY_RECORDING)
+    {
+        RecordReplayInput(game->replay, &input, IsGameBusy(game));
+    }
+
+    // F9 starts a trace, pressing it again writes everything recorded so far
+    if (input.toggleTrace)
+    {
+        if (IsTracing())
+        {
+            StopTracing();
+            DumpTrace("trace.json");
+        }
+        else
+        {
+            StartTracing();
+            GAME_LOG_INFO("Tracing started, press F9 again to write trace.json");
+        }
+
+        changed = true;
+    }
+
+    // Only the view changes, so zooming never takes a turn (or ends up in a replay)
+    if (input.zoomSteps != 0)
+    {
+        const float zoom = ApplyZoomSteps(game->zoom, input.zoomSteps);
+
+        changed |= zoom != game->zoom;
+        game->zoom = zoom;
+    }
+
+    if (input.regenerate)
+    {
+        GAME_LOG_INFO("Regenerating dungeon...");
+        game->transitioningFloors = true;
+        return true;
+    }
+
     if (!game->dungeonGenerated || game->transitioningFloors)
     {
         if (GenerateFloor(game))
         {
             game->dungeonGenerated = true;
             game->transitioningFloors = false;
+            return true;
         }
-        return;
+        return changed; // Failed attempt, still busy so the next frame tries again
+    }
+
+    // Any key interrupts travel, the key itself is still handled as usual below
+    if (game->travel.mode != TRAVEL_NONE && input.anyKey)
+    {
+        StopTravel(&game->travel);
+        GAME_LOG_INFO("Travel interrupted");
+        changed = true;
     }
 
     int targetX, targetY;
-    ActionType actionType;
 
-    if (HandlePlayerInput(&game->player, game->grid, &actionType, &targetX, &targetY))
+    if (input.explore)
+    {
+        if (!StartExplore(&game->travel, &game->masks, &game->explored, game->playerPos.x, game->playerPos.y))
+        {
+            GAME_LOG_INFO("Nothing left to explore on this floor!");
+        }
+    }
+    else if (input.travel)
+    {
+        if (!StartTravel(&game->travel, &game->masks, game->playerPos.x, game->playerPos.y,
+                         input.travelX, input.travelY))
+        {
+            GAME_LOG_INFO("Can't travel to (%d,%d)", input.travelX, input.travelY);
+        }
+    }
+
+    if (game->travel.mode != TRAVEL_NONE)
     {
-        game->turnCounter++;
+        RunTravel(game);
+        return changed || game->turnCounter != turnBefore;
+    }
+
+    ActionType actionType;
 
+    if (HandlePlayerInput(&game->player, game->grid, &game->masks, game->entities, &input,
+                          &actionType, &targetX, &targetY))
+    {
         switch (actionType)
         {
             case ACTION_MOVE:
             {
-                UpdatePlayerPosition(&game->player, targetX, targetY);
-                game->playerPos.x = targetX;
-                game->playerPos.y = targetY;
+                MovePlayer(game, targetX, targetY);
 
-                printf("Player moved to (%d,%d) - Turn: %d\n",
-                       targetX, targetY, game->turnCounter);
+                GAME_LOG_DEBUG("Player moved to (%d,%d) - Turn: %d",
+                               targetX, targetY, game->turnCounter);
             }
             break;
 
             case ACTION_USE_STAIRS:
             {
+                game->turnCounter++;
+
                 int playerCell = game->grid[game->player.y][game->player.x];
 
                 if (playerCell == CELL_STAIR_DOWN)
                 {
                     GoDownStairs(game);
-                    return;
+                    return true;
                 }
                 else if (playerCell == CELL_STAIR_UP && game->currentFloor > 1)
                 {
                     GoUpStairs(game);
-                    return;
+                    return true;
                 }
             }
             break;
         }
     }
+
+    return changed || game->turnCounter != turnBefore;
+}
+
+/* Only what the player can see right now, monsters don't stay on the map once out of sight.
+ * We walk the cells the camera sees instead of every entity, a row with no occupied and visible cell
+ * is skipped with a few word ANDs, and only the lists of the cells left are looked at.
+ */
+static void DrawEntities(const Game* game, RenderBackend* render, const TileRect* tiles)
+{
+    const EntityStore* store = game->entities;
+
+    if (store == NULL)
+    {
+        return;
+    }
+
+    for (int y = tiles->minY; y <= tiles->maxY; y++)
+    {
+        uint64_t rowBits = 0;
+
+        for (int word = tiles->minX >> 6; word <= tiles->maxX >> 6; word++)
+        {
+            rowBits |= store->occupied.rows[y][word] & game->visible.rows[y][word];
+        }
+
+        if (rowBits == 0)
+        {
+            continue;
+        }
+
+        for (int x = tiles->minX; x <= tiles->maxX; x++)
+        {
+            if (!GET_GRID_BIT(&store->occupied, x, y) || !GET_GRID_BIT(&game->visible, x, y))
+            {
+                continue;
+            }
+
+            const int drawX = x * CELL_SIZE;
+            const int drawY = y * CELL_SIZE;
+
+            for (int i = GetFirstEntityAt(store, x, y); i != ENTITY_NONE; i = store->cellNext[i])
+            {
+                if (store->kind[i] == ENTITY_MONSTER)
+                {
+                    render->drawCircle(render, drawX + CELL_SIZE / 2, drawY + CELL_SIZE / 2, CELL_SIZE / 3, RED);
+                }
+                else
+                {
+                    render->drawRectangle(render, drawX + CELL_SIZE / 4, drawY + CELL_SIZE / 4, CELL_SIZE / 2, CELL_SIZE / 2, GOLD);
+                }
+            }
+        }
+    }
+}
+
+// Centred on the player, call it with the size of the frame (or window) it's for
+Camera2D GetGameCamera(const Game* game, int frameWidth, int frameHeight)
+{
+    return GetFollowCamera(game->playerPos.x, game->playerPos.y, game->zoom, frameWidth, frameHeight);
 }
 
-void DrawGame(Game game)
+void DrawGame(const Game* game, RenderBackend* render)
 {
-    BeginDrawing();
+    TRACE_BEGIN(drawZone, "DrawGame");
+
+    render->beginFrame(render, RAYWHITE);
     {
-        ClearBackground(RAYWHITE);
-        PrintDungeon(game.grid, game.rooms, game.roomCount);
+        const Camera2D camera = GetGameCamera(game, render->width, render->height);
+        const TileRect tiles = GetVisibleTiles(&camera, render->width, render->height);
 
-        const int totalHeight = GRID_TOTAL_HEIGHT;
-        const int totalWidth = GRID_TOTAL_WIDTH;
-        const int startX = CENTER_SCREEN_X(totalWidth);
-        const int startY = CENTER_SCREEN_Y(totalHeight);
+        // The floor and everything on it in world space, the HUD stays put on the screen
+        render->beginCamera(render, camera);
+        {
+            PrintDungeon(render, &tiles, game->grid, game->rooms, game->roomCount, &game->explored, &game->visible);
+            DrawEntities(game, render, &tiles);
+
+            render->drawCircle
+            (
+                render,
+                (game->playerPos.x * CELL_SIZE) + CELL_SIZE / 2,
+                (game->playerPos.y * CELL_SIZE) + CELL_SIZE / 2,
+                CELL_SIZE / 3,
+                YELLOW
+            );
+        }
+        render->endCamera(render);
 
-        DrawCircle
-        (
-            startX + (game.playerPos.x * CELL_SIZE) + CELL_SIZE / 2,
-            startY + (game.playerPos.y * CELL_SIZE) + CELL_SIZE / 2,
-            CELL_SIZE / 3,
-            YELLOW
-        );
+        if (game->minimap != NULL)
+        {
+            DrawMinimap(game->minimap, render, game->playerPos.x, game->playerPos.y);
+        }
 
         char floorText[20];
-        sprintf(floorText, "Floor: %d", game.currentFloor);
-        DrawText(floorText, 40, 40, 30, BLACK);
+        sprintf(floorText, "Floor: %d", game->currentFloor);
+        render->drawText(render, floorText, 40, 40, 30, BLACK);
 
         char turnText[20];
-        sprintf(turnText, "Turn: %d", game.turnCounter);
-        DrawText(turnText, 40, 100, 30, BLACK);
+        sprintf(turnText, "Turn: %d", game->turnCounter);
+        render->drawText(render, turnText, 40, 100, 30, BLACK);
+
+        const int stairsDistance = GetMapDistance(&game->stairDownDistances, game->playerPos.x, game->playerPos.y);
 
-        DrawText("WASD/ARROW - MOVE", 40, 220, 26, DARKGRAY);
-        DrawText("SPACE - USE STAIRCASE", 40, 260, 26, DARKGRAY);
-        DrawText("G - Generate New Dungeon", 40, 300, 26, DARKGRAY);
+        if (stairsDistance != DISTANCE_MAP_UNREACHABLE)
+        {
+            char stairsText[32];
+            sprintf(stairsText, "Stairs: %d steps", stairsDistance);
+            render->drawText(render, stairsText, 40, 160, 30, BLACK);
+        }
+
+        render->drawText(render, "WASD/ARROW - MOVE", 40, 220, 26, DARKGRAY);
+        render->drawText(render, "SPACE - USE STAIRCASE", 40, 260, 26, DARKGRAY);
+        render->drawText(render, "CLICK - Travel To Cell", 40, 300, 26, DARKGRAY);
+        render->drawText(render, "X - Auto Explore", 40, 340, 26, DARKGRAY);
+        render->drawText(render, "G - Generate New Dungeon", 40, 380, 26, DARKGRAY);
+        render->drawText(render, "WHEEL/+/- - Zoom", 40, 420, 26, DARKGRAY);
+        render->drawText(render, IsTracing() ? "F9 - Stop Trace" : "F9 - Start Trace", 40, 460, 26, DARKGRAY);
     }
-    EndDrawing();
+    render->endFrame(render);
+
+    TRACE_END(drawZone);
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+﻿#include "GameInput.h"
+#include "Viewport.h"
+
+/* Same keys as always: WASD or the arrows (two at once for diagonals), Space for stairs,
+ * X to explore, a left click to travel, G to regenerate, the wheel or +/- to zoom and F9 for tracing.
+ * The camera is the one the last frame was drawn with, so clicks land on the cell under the mouse.
+ */
+GameInput ReadKeyboardInput(const Camera2D* camera)
+{
+    GameInput input = { 0 };
+
+    if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP))
+    {
+        input.moveY = -1;
+    }
+    else if (IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN))
+    {
+        input.moveY = 1;
+    }
+
+    if (IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT))
+    {
+        input.moveX = -1;
+    }
+    else if (IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT))
+    {
+        input.moveX = 1;
+    }
+
+    input.useStairs = IsKeyPressed(KEY_SPACE);
+    input.explore = IsKeyPressed(KEY_X);
+    input.regenerate = IsKeyPressed(KEY_G);
+    input.toggleTrace = IsKeyPressed(KEY_F9);
+    input.anyKey = GetKeyPressed() != 0;
+
+    const float wheel = GetMouseWheelMove();
+    input.zoomSteps = (wheel > 0.0f) - (wheel < 0.0f);
+    input.zoomSteps += (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) ? 1 : 0;
+    input.zoomSteps -= (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) ? 1 : 0;
+
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
+    {
+        input.travel = ScreenToGridCell(camera, GetMousePosition(), &input.travelX, &input.travelY);
+    }
+
+    return input;
+}
\ No newline at end of file
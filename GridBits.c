@@ -0,0 +1,79 @@
+﻿#include "GridBits.h"
+#include <string.h>
+
+void ClearGridBits(GridBits* bits)
+{
+    memset(bits, 0, sizeof(*bits));
+}
+
+// bits |= other, a whole row word at a time
+void OrGridBits(GridBits* bits, const GridBits* other)
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int word = 0; word < GRID_ROW_WORDS; word++)
+        {
+            bits->rows[y][word] |= other->rows[y][word];
+        }
+    }
+}
+
+// Here, we pack the cell codes into bits one row at a time, so each word is only written once
+void BuildFloorMasks(FloorMasks* masks, int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int word = 0; word < GRID_ROW_WORDS; word++)
+        {
+            uint64_t walkable = 0;
+            uint64_t opaque = 0;
+
+            const int firstX = word * 64;
+            const int lastX = (firstX + 64 < GRID_WIDTH) ? firstX + 64 : GRID_WIDTH;
+
+            for (int x = firstX; x < lastX; x++)
+            {
+                const uint64_t bit = (uint64_t)1 << (x & 63);
+                const unsigned int flags = cellFlags[CELL_TYPE_INDEX(grid[y][x])];
+
+                // Branchless, each flag lands straight in its bit
+                walkable |= (flags & CELL_FLAG_WALKABLE) ? bit : 0;
+                opaque |= (flags & CELL_FLAG_OPAQUE) ? bit : 0;
+            }
+
+            masks->walkable.rows[y][word] = walkable;
+            masks->opaque.rows[y][word] = opaque;
+        }
+    }
+}
+
+void UpdateFloorMaskCell(FloorMasks* masks, int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return;
+    }
+
+    if (IS_WALKABLE(grid[y][x]))
+    {
+        SET_GRID_BIT(&masks->walkable, x, y);
+    }
+    else
+    {
+        CLEAR_GRID_BIT(&masks->walkable, x, y);
+    }
+
+    if (IS_OPAQUE(grid[y][x]))
+    {
+        SET_GRID_BIT(&masks->opaque, x, y);
+    }
+    else
+    {
+        CLEAR_GRID_BIT(&masks->opaque, x, y);
+    }
+}
+
+bool IsWalkable(const FloorMasks* masks, int x, int y)
+{
+    return IS_IN_GRID(x, y) && GET_GRID_BIT(&masks->walkable, x, y);
+}
\ No newline at end of file
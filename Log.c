@@ -0,0 +1,224 @@
+﻿#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L // For nanosleep under -std=c11
+#endif
+
+#include "Log.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// NOTE: Like FileMap.c, this file must not include raylib.h because of windows.h!
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <time.h>
+#endif
+
+_Static_assert((LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "LOG_RING_CAPACITY must be a power of 2!");
+
+typedef struct LogRecord {
+    int level;
+    char text[LOG_MESSAGE_SIZE];
+} LogRecord;
+
+/* A single-producer / single-consumer ring.
+ * Only the owning thread moves head, only the drain thread moves tail,
+ * so neither side ever has to take a lock!
+ */
+typedef struct LogRing {
+    LogRecord records[LOG_RING_CAPACITY];
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_uint dropped;
+    struct LogRing* next;
+} LogRing;
+
+static const char* const levelNames[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+
+// Rings are never freed, a thread might still hold a pointer to its ring
+static _Atomic(LogRing*) ringList = NULL;
+static _Thread_local LogRing* threadRing = NULL;
+static atomic_bool loggerRunning = false;
+
+#if defined(_WIN32)
+    static HANDLE drainThread;
+#else
+    static pthread_t drainThread;
+#endif
+
+static LogRing* GetThreadRing(void)
+{
+    if (threadRing != NULL)
+    {
+        return threadRing;
+    }
+
+    LogRing* ring = calloc(1, sizeof(LogRing));
+    if (ring == NULL)
+    {
+        return NULL;
+    }
+
+    // Push onto the global list, the drain thread walks it to find every thread's ring
+    ring->next = atomic_load(&ringList);
+    while (!atomic_compare_exchange_weak(&ringList, &ring->next, ring))
+    {
+    }
+
+    threadRing = ring;
+    return ring;
+}
+
+static void PrintRecord(const LogRecord* record)
+{
+    fprintf(stdout, "[%s] %s\n", levelNames[record->level], record->text);
+}
+
+// Writes out everything currently queued, returns how many records were written
+static int DrainRings(void)
+{
+    int written = 0;
+
+    for (LogRing* ring = atomic_load(&ringList); ring != NULL; ring = ring->next)
+    {
+        const unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+        while (tail != head)
+        {
+            PrintRecord(&ring->records[tail & (LOG_RING_CAPACITY - 1)]);
+            tail++;
+            written++;
+        }
+
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+
+        const unsigned int dropped = atomic_exchange(&ring->dropped, 0);
+        if (dropped > 0)
+        {
+            fprintf(stdout, "[WARN] Logger dropped %u messages, ring buffer was full\n", dropped);
+        }
+    }
+
+    if (written > 0)
+    {
+        fflush(stdout);
+    }
+
+    return written;
+}
+
+static void SleepMilliseconds(int milliseconds)
+{
+#if defined(_WIN32)
+    Sleep((DWORD)milliseconds);
+#else
+    struct timespec duration = { 0, milliseconds * 1000000L };
+    nanosleep(&duration, NULL);
+#endif
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI DrainLoop(LPVOID argument)
+#else
+static void* DrainLoop(void* argument)
+#endif
+{
+    (void)argument;
+    const int DRAIN_INTERVAL_MS = 5;
+
+    while (atomic_load(&loggerRunning))
+    {
+        // Only sleep when there was nothing to do, bursts get drained back to back
+        if (DrainRings() == 0)
+        {
+            SleepMilliseconds(DRAIN_INTERVAL_MS);
+        }
+    }
+
+    DrainRings(); // Whatever came in while we were shutting down
+    return 0;
+}
+
+void StartLogger(void)
+{
+    if (atomic_load(&loggerRunning))
+    {
+        return;
+    }
+
+    atomic_store(&loggerRunning, true);
+
+#if defined(_WIN32)
+    drainThread = CreateThread(NULL, 0, DrainLoop, NULL, 0, NULL);
+    const bool started = drainThread != NULL;
+#else
+    const bool started = pthread_create(&drainThread, NULL, DrainLoop, NULL) == 0;
+#endif
+
+    if (!started)
+    {
+        atomic_store(&loggerRunning, false);
+        fprintf(stdout, "[WARN] Could not start the log thread, logging synchronously\n");
+    }
+}
+
+void StopLogger(void)
+{
+    if (!atomic_exchange(&loggerRunning, false))
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    WaitForSingleObject(drainThread, INFINITE);
+    CloseHandle(drainThread);
+#else
+    pthread_join(drainThread, NULL);
+#endif
+}
+
+void WriteLog(int level, const char* format, ...)
+{
+    if (level < LOG_LEVEL_DEBUG || level > LOG_LEVEL_ERROR)
+    {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+
+    LogRing* ring = atomic_load(&loggerRunning) ? GetThreadRing() : NULL;
+
+    if (ring == NULL)
+    {
+        // No drain thread, just write it out right away
+        LogRecord record = { .level = level };
+        vsnprintf(record.text, sizeof(record.text), format, args);
+        PrintRecord(&record);
+        va_end(args);
+        return;
+    }
+
+    const unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail >= LOG_RING_CAPACITY)
+    {
+        // Full! We'd rather lose a message than stall the game
+        atomic_fetch_add(&ring->dropped, 1);
+        va_end(args);
+        return;
+    }
+
+    LogRecord* record = &ring->records[head & (LOG_RING_CAPACITY - 1)];
+    record->level = level;
+    vsnprintf(record->text, sizeof(record->text), format, args);
+    va_end(args);
+
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
\ No newline at end of file
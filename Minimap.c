@@ -0,0 +1,160 @@
+﻿#include "Minimap.h"
+#include "Dungeon.h"
+#include "Log.h"
+#include <stdlib.h>
+
+Minimap* CreateMinimap(void)
+{
+    Minimap* minimap = malloc(sizeof(Minimap));
+
+    if (minimap == NULL)
+    {
+        GAME_LOG_ERROR("Minimap allocation failed!");
+        return NULL;
+    }
+
+    minimap->texture = RENDER_NO_TEXTURE;
+    ResetMinimap(minimap);
+
+    return minimap;
+}
+
+// The texture goes with the backend, call ReleaseMinimapTexture first
+void DestroyMinimap(Minimap* minimap)
+{
+    free(minimap);
+}
+
+// A new floor, nothing explored yet, and the whole texture has to be cleared on the next upload
+void ResetMinimap(Minimap* minimap)
+{
+    for (int i = 0; i < MINIMAP_WIDTH * MINIMAP_HEIGHT; i++)
+    {
+        minimap->pixels[i] = BLANK;
+    }
+
+    ClearGridBits(&minimap->drawn);
+    minimap->dirtyMinY = 0;
+    minimap->dirtyMaxY = MINIMAP_HEIGHT - 1;
+}
+
+/* With more than one cell per pixel, the cell the player cares most about wins:
+ * stairs over everything, then anything walkable, then walls. Ties go to the higher cell type,
+ * so a pixel ends up the same no matter in which order its cells were explored.
+ */
+static int GetCellRank(int cell)
+{
+    const int type = CELL_TYPE_INDEX(cell);
+
+    if (cell == CELL_STAIR_UP || cell == CELL_STAIR_DOWN)
+    {
+        return (2 << 8) | type;
+    }
+
+    return ((IS_WALKABLE(cell) ? 1 : 0) << 8) | type;
+}
+
+static void PaintCell(Minimap* minimap, const int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
+{
+    const int pixelX = x / MINIMAP_SCALE;
+    const int pixelY = y / MINIMAP_SCALE;
+    const int cell = grid[y][x];
+    Color* pixel = &minimap->pixels[pixelY * MINIMAP_WIDTH + pixelX];
+
+    // A pixel that already shows something at least as important stays as it is
+    if (MINIMAP_SCALE > 1 && pixel->a != 0)
+    {
+        const int lastX = ((pixelX + 1) * MINIMAP_SCALE < GRID_WIDTH) ? (pixelX + 1) * MINIMAP_SCALE : GRID_WIDTH;
+        const int lastY = ((pixelY + 1) * MINIMAP_SCALE < GRID_HEIGHT) ? (pixelY + 1) * MINIMAP_SCALE : GRID_HEIGHT;
+
+        for (int cy = pixelY * MINIMAP_SCALE; cy < lastY; cy++)
+        {
+            for (int cx = pixelX * MINIMAP_SCALE; cx < lastX; cx++)
+            {
+                if (GET_GRID_BIT(&minimap->drawn, cx, cy) && GetCellRank(grid[cy][cx]) >= GetCellRank(cell))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    *pixel = GetCellColour(cell);
+
+    minimap->dirtyMinY = (pixelY < minimap->dirtyMinY) ? pixelY : minimap->dirtyMinY;
+    minimap->dirtyMaxY = (pixelY > minimap->dirtyMaxY) ? pixelY : minimap->dirtyMaxY;
+}
+
+/* Only explored & ~drawn is looked at, a word at a time, and only in the rows and words of area
+ * (the field of view is all that can change in one step). A step that reveals nothing new
+ * costs one pass over a handful of words and that's it!
+ */
+void UpdateMinimap(Minimap* minimap, const int grid[GRID_HEIGHT][GRID_WIDTH], const GridBits* explored,
+                   const TileRect* area)
+{
+    for (int y = area->minY; y <= area->maxY; y++)
+    {
+        for (int word = area->minX >> 6; word <= area->maxX >> 6; word++)
+        {
+            uint64_t fresh = explored->rows[y][word] & ~minimap->drawn.rows[y][word];
+
+            for (int bit = 0; fresh != 0; bit++, fresh >>= 1)
+            {
+                if (fresh & 1)
+                {
+                    PaintCell(minimap, grid, word * 64 + bit, y);
+                    SET_GRID_BIT(&minimap->drawn, word * 64 + bit, y);
+                }
+            }
+        }
+    }
+}
+
+// Uploads the changed rows (if any), then one quad for the map and one for the player
+void DrawMinimap(Minimap* minimap, RenderBackend* render, int playerX, int playerY)
+{
+    if (minimap->texture == RENDER_NO_TEXTURE)
+    {
+        minimap->texture = render->createTexture(render, MINIMAP_WIDTH, MINIMAP_HEIGHT);
+
+        if (minimap->texture == RENDER_NO_TEXTURE)
+        {
+            return;
+        }
+
+        minimap->dirtyMinY = 0;
+        minimap->dirtyMaxY = MINIMAP_HEIGHT - 1;
+    }
+
+    if (minimap->dirtyMinY <= minimap->dirtyMaxY)
+    {
+        render->updateTexture(render, minimap->texture, minimap->dirtyMinY,
+                              minimap->dirtyMaxY - minimap->dirtyMinY + 1,
+                              &minimap->pixels[minimap->dirtyMinY * MINIMAP_WIDTH]);
+
+        minimap->dirtyMinY = MINIMAP_HEIGHT;
+        minimap->dirtyMaxY = -1;
+    }
+
+    const int side = (MINIMAP_WIDTH > MINIMAP_HEIGHT) ? MINIMAP_WIDTH : MINIMAP_HEIGHT;
+    const float scale = (float)MINIMAP_SCREEN_SIZE / side;
+    const int x = render->width - MINIMAP_SCREEN_SIZE - MINIMAP_SCREEN_MARGIN;
+    const int y = MINIMAP_SCREEN_MARGIN;
+
+    render->drawRectangle(render, x, y, MINIMAP_SCREEN_SIZE, MINIMAP_SCREEN_SIZE, FadeColour(BLACK, 0.6f));
+    render->drawTexture(render, minimap->texture, x, y, scale, WHITE);
+
+    const int dotSize = (scale > 3.0f) ? (int)scale : 3;
+
+    render->drawRectangle(render, x + (int)((playerX / MINIMAP_SCALE) * scale),
+                          y + (int)((playerY / MINIMAP_SCALE) * scale), dotSize, dotSize, YELLOW);
+}
+
+void ReleaseMinimapTexture(Minimap* minimap, RenderBackend* render)
+{
+    if (minimap != NULL && minimap->texture != RENDER_NO_TEXTURE)
+    {
+        render->destroyTexture(render, minimap->texture);
+        minimap->texture = RENDER_NO_TEXTURE;
+    }
+}
\ No newline at end of file
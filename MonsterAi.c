@@ -0,0 +1,203 @@
+﻿#include "MonsterAi.h"
+#include <stdlib.h>
+#include "Log.h"
+
+// Straight steps first, same as the player
+static const int aiDirX[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+static const int aiDirY[] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+
+MonsterAi* CreateMonsterAi(void)
+{
+    MonsterAi* ai = malloc(sizeof(MonsterAi));
+
+    if (ai == NULL)
+    {
+        GAME_LOG_ERROR("Monster AI allocation failed!");
+        return NULL;
+    }
+
+    ClearDistanceMap(&ai->flee);
+    ai->orderCount = 0;
+    ai->loweredCount = 0;
+    ai->huntingCount = 0;
+    ai->fleeingCount = 0;
+    ai->fleeMapBuilt = false;
+
+    return ai;
+}
+
+void DestroyMonsterAi(MonsterAi* ai)
+{
+    free(ai);
+}
+
+/* One linear pass over the columns, once per player turn.
+ * Only positions, health and the state column are touched, so this stays cheap with a full store!
+ */
+void UpdateMonsterStates(MonsterAi* ai, EntityStore* store, const DistanceMap* toward)
+{
+    int hunting = 0;
+    int fleeing = 0;
+
+    for (int i = 0; i < store->highWater; i++)
+    {
+        if (!store->alive[i] || store->kind[i] != ENTITY_MONSTER)
+        {
+            continue;
+        }
+
+        const int distance = toward->distance[GET_GRID_INDEX(store->x[i], store->y[i])];
+        AiState state = AI_IDLE;
+
+        if (distance <= MONSTER_AWARENESS_RANGE)
+        {
+            state = (store->health[i] <= MONSTER_FLEE_HEALTH) ? AI_FLEEING : AI_HUNTING;
+        }
+
+        store->aiState[i] = (uint8_t)state;
+        hunting += (state == AI_HUNTING);
+        fleeing += (state == AI_FLEEING);
+    }
+
+    ai->huntingCount = hunting;
+    ai->fleeingCount = fleeing;
+    ai->fleeMapBuilt = false;
+}
+
+/* Scale the player map by -FLEE_SCALE_NUM / FLEE_SCALE_DEN around the player, then settle it.
+ * The scaled values keep the order of the player map (just backwards), so a counting sort on the
+ * player distance gives SettleDistanceMap its sources in order, no comparison sort needed!
+ *
+ * Only the box FLEE_HORIZON cells around the player can hold cells within FLEE_HORIZON turns,
+ * and we only reset the cells the previous build touched, so nothing here scans the whole floor.
+ */
+void BuildFleeMap(MonsterAi* ai, const DistanceMap* toward, const FloorMasks* masks)
+{
+    for (int i = 0; i < ai->orderCount; i++)
+    {
+        ai->flee.distance[ai->order[i]] = DISTANCE_MAP_UNREACHABLE;
+    }
+
+    for (int i = 0; i < ai->loweredCount; i++)
+    {
+        ai->flee.distance[ai->flee.queue[i]] = DISTANCE_MAP_UNREACHABLE;
+    }
+
+    ai->orderCount = 0;
+    ai->loweredCount = 0;
+    ai->fleeMapBuilt = false;
+
+    if (toward->sourceX < 0)
+    {
+        return;
+    }
+
+    const int minX = (toward->sourceX - FLEE_HORIZON < 0) ? 0 : toward->sourceX - FLEE_HORIZON;
+    const int maxX = (toward->sourceX + FLEE_HORIZON >= GRID_WIDTH) ? GRID_WIDTH - 1 : toward->sourceX + FLEE_HORIZON;
+    const int minY = (toward->sourceY - FLEE_HORIZON < 0) ? 0 : toward->sourceY - FLEE_HORIZON;
+    const int maxY = (toward->sourceY + FLEE_HORIZON >= GRID_HEIGHT) ? GRID_HEIGHT - 1 : toward->sourceY + FLEE_HORIZON;
+
+    for (int d = 0; d <= FLEE_HORIZON; d++)
+    {
+        ai->counts[d] = 0;
+    }
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            const int distance = toward->distance[GET_GRID_INDEX(x, y)];
+
+            if (distance <= FLEE_HORIZON)
+            {
+                ai->counts[distance]++;
+            }
+        }
+    }
+
+    // Farthest from the player first, that's the lowest flee value
+    int orderCount = 0;
+
+    for (int d = FLEE_HORIZON; d >= 0; d--)
+    {
+        const int count = ai->counts[d];
+        ai->counts[d] = orderCount;
+        orderCount += count;
+    }
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            const int index = GET_GRID_INDEX(x, y);
+            const int distance = toward->distance[index];
+
+            if (distance <= FLEE_HORIZON)
+            {
+                ai->flee.distance[index] = -(distance * FLEE_SCALE_NUM) / FLEE_SCALE_DEN;
+                ai->order[ai->counts[distance]++] = index;
+            }
+        }
+    }
+
+    ai->orderCount = orderCount;
+
+    // Cells past the horizon still get a value from the edge, but only while it stays below 0
+    ai->loweredCount = SettleDistanceMap(&ai->flee, masks, ai->order, orderCount, 0);
+    ai->fleeMapBuilt = true;
+}
+
+/* One monster's move, a handful of loads from the shared maps.
+ * Hunting monsters go downhill on the player map and stop next to the player,
+ * fleeing ones go downhill on the flee map, idle ones stay put.
+ */
+void StepMonster(const MonsterAi* ai, EntityStore* store, int monster, const DistanceMap* toward,
+                 const FloorMasks* masks, int playerX, int playerY)
+{
+    const DistanceMap* map;
+
+    switch (store->aiState[monster])
+    {
+        case AI_HUNTING: map = toward; break;
+        case AI_FLEEING: map = ai->fleeMapBuilt ? &ai->flee : NULL; break;
+        default: map = NULL; break;
+    }
+
+    if (map == NULL)
+    {
+        return;
+    }
+
+    const int x = store->x[monster];
+    const int y = store->y[monster];
+
+    int bestX = x;
+    int bestY = y;
+    int bestDistance = map->distance[GET_GRID_INDEX(x, y)];
+
+    for (int i = 0; i < 8; i++)
+    {
+        const int newX = x + aiDirX[i];
+        const int newY = y + aiDirY[i];
+
+        if (!IsWalkable(masks, newX, newY) || (newX == playerX && newY == playerY))
+        {
+            continue;
+        }
+
+        const int newIndex = GET_GRID_INDEX(newX, newY);
+
+        // Another monster in the way, the next best cell will do
+        if (map->distance[newIndex] < bestDistance && store->occupant[newIndex] == ENTITY_NONE)
+        {
+            bestX = newX;
+            bestY = newY;
+            bestDistance = map->distance[newIndex];
+        }
+    }
+
+    if (bestX != x || bestY != y)
+    {
+        MoveEntity(store, monster, bestX, bestY);
+    }
+}
\ No newline at end of file
@@ -1,10 +1,12 @@
 ﻿#include "Path.h"
 #include <raylib.h>
+#include <limits.h>
 #include <stdbool.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "Door.h"
+#include "Log.h"
+#include "Trace.h"
 
 /* Direction vectors for cardinal movement (N, E, S, W)
  * These vectors allow us to explore adjacent cells in the grid
@@ -68,7 +70,7 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
     *connected = calloc(roomCount, sizeof(bool));
     if (*connected == NULL)
     {
-        printf("Connected array allocation failed!\n");
+        GAME_LOG_ERROR("Connected array allocation failed!");
         return false;
     }
 
@@ -76,7 +78,7 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
     *queue = malloc(GRID_SIZE * sizeof(Corridor));
     if (*queue == NULL)
     {
-        printf("Queue allocation failed!\n");
+        GAME_LOG_ERROR("Queue allocation failed!");
         free(*connected);
         return false;
     }
@@ -85,7 +87,7 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
     *visited = calloc(GRID_SIZE, sizeof(bool));
     if (*visited == NULL)
     {
-        printf("Visited array allocation failed!\n");
+        GAME_LOG_ERROR("Visited array allocation failed!");
         free(*connected);
         free(*queue);
         return false;
@@ -95,7 +97,7 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
     *previous = malloc(GRID_SIZE * sizeof(Corridor));
     if (*previous == NULL)
     {
-        printf("Previous array allocation failed!\n");
+        GAME_LOG_ERROR("Previous array allocation failed!");
         free(*connected);
         free(*queue);
         free(*visited);
@@ -104,7 +106,7 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
 
     if (!FindDoorPosition(grid, rooms[startRoomIndex], startDoorX, startDoorY))
     {
-        printf("No door found for starting room!\n");
+        GAME_LOG_WARN("No door found for starting room!");
         free(*connected);
         free(*queue);
         free(*visited);
@@ -123,50 +125,58 @@ static bool InitializePathfinding(bool** connected, Corridor** queue, bool** vis
  * We're only trying  to "connect the seams", so that no room or mazes are unconnected.
  * Everything must be traversable!
  *
- * To do this, this function counts the number of distinct corridor networks surrounding the cell.
- * A valid "seam connector" should connect at least two separate networks.
+ * The corridor regions tell us which network every cell belongs to, so we simply compare
+ * the network we're coming from with the networks around the new cell.
+ * A valid "seam connector" touches a different network, or has one within CELL_SCOUT_AMOUNT
+ * cells straight ahead, since wider gaps take a few new cells in a row to bridge.
  */
-static bool ConnectsDistinctCorridors(int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y)
+static bool ConnectsDistinctCorridors(CorridorRegions* regions, int grid[GRID_HEIGHT][GRID_WIDTH],
+                                      int fromX, int fromY, int x, int y, int direction)
 {
-    // Track adjacent positions that belong to corridors/paths
-    bool hasCorridorN = false;
-    bool hasCorridorS = false;
-    bool hasCorridorE = false;
-    bool hasCorridorW = false;
+    const int fromRegion = FindRegion(regions, fromX, fromY);
 
-    // Check each cardinal direction
-    if (IS_IN_GRID(x, y-1) && (grid[y-1][x] == CELL_CORRIDOR || grid[y-1][x] == CELL_PATH))
+    // Coming from a new path cell means we're already halfway across a seam
+    if (fromRegion == REGION_NONE)
     {
-        hasCorridorN = true;
+        return true;
     }
 
-    if (IS_IN_GRID(x, y+1) && (grid[y+1][x] == CELL_CORRIDOR || grid[y+1][x] == CELL_PATH))
+    // Check each cardinal direction
+    for (int i = 0; i < 4; i++)
     {
-        hasCorridorS = true;
-    }
+        const int region = FindRegion(regions, x + dirX[i], y + dirY[i]);
 
-    if (IS_IN_GRID(x+1, y) && (grid[y][x+1] == CELL_CORRIDOR || grid[y][x+1] == CELL_PATH))
-    {
-        hasCorridorE = true;
+        if (region != REGION_NONE && region != fromRegion)
+        {
+            return true;
+        }
     }
 
-    if (IS_IN_GRID(x-1, y) && (grid[y][x-1] == CELL_CORRIDOR || grid[y][x-1] == CELL_PATH))
+    // Scout ahead across empty cells for the other side of the seam
+    for (int step = 2; step <= CELL_SCOUT_AMOUNT + 1; step++)
     {
-        hasCorridorW = true;
-    }
+        const int scoutX = x + dirX[direction] * step;
+        const int scoutY = y + dirY[direction] * step;
+
+        if (!IS_VALID_CELL(scoutX, scoutY))
+        {
+            break;
+        }
+
+        const int region = FindRegion(regions, scoutX, scoutY);
 
-    // Calculate north-south and east-west connections
-    bool connectsNS = hasCorridorN && hasCorridorS;
-    bool connectsEW = hasCorridorE && hasCorridorW;
+        if (region != REGION_NONE)
+        {
+            return region != fromRegion;
+        }
 
-    // Also check for L-shaped connections (exactly two adjacent corridors that aren't opposite)
-    bool lConnection = ((hasCorridorN && hasCorridorE) ||
-                       (hasCorridorN && hasCorridorW) ||
-                       (hasCorridorS && hasCorridorE) ||
-                       (hasCorridorS && hasCorridorW));
+        if (!IS_EMPTY(grid[scoutY][scoutX]))
+        {
+            break;
+        }
+    }
 
-    // Return true if this cell creates an efficient corridor connection
-    return connectsNS || connectsEW || lConnection;
+    return false;
 }
 
 /* This is a helper function which checks if a position (for path cells) is adjacent rooms.
@@ -327,8 +337,12 @@ static void PrioritizeDirections(int directions[4], int currentX, int currentY,
  */
 static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
     Corridor currentDoor, int nextDoorX, int nextDoorY,
-    Corridor* queue, bool* visited, Corridor* previous)
+    Corridor* queue, bool* visited, Corridor* previous,
+    CorridorRegions* regions, GenerationStats* stats)
 {
+    TRACE_BEGIN(searchZone, "FindPathBetweenDoors");
+    stats->pathSearches++;
+
     // Calculate direct distance and maximum allowed path length
     int directDistance = abs(nextDoorX - currentDoor.x) + abs(nextDoorY - currentDoor.y);
     int maxAllowedLength = (int)(directDistance * PATH_LENGTH_THRESHOLD);
@@ -353,6 +367,7 @@ static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
     while (queueFront < queueBack)
     {
         Corridor current = queue[queueFront++];
+        stats->pathNodesExpanded++;
 
         // Get direction priority based on target
         int directions[4];
@@ -378,6 +393,7 @@ static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
             if (newX == nextDoorX && newY == nextDoorY)
             {
                 previous[GET_GRID_INDEX(newX, newY)] = current;
+                TRACE_END(searchZone);
                 return true;
             }
 
@@ -396,25 +412,11 @@ static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
                      newPathCount < MAX_NEW_PATH_CELLS)
             {
 
-                // Only place path cells that truly connect corridor networks
-                // or are immediately adjacent to existing paths/corridors
-                bool connectsNetworks = ConnectsDistinctCorridors(grid, newX, newY);
-                bool adjacentToPath = false;
-
-                for (int dir = 0; dir < 4; dir++)
-                {
-                    int adjX = newX + dirX[dir];
-                    int adjY = newY + dirY[dir];
-
-                    if (IS_IN_GRID(adjX, adjY) &&
-                        (grid[adjY][adjX] == CELL_CORRIDOR || grid[adjY][adjX] == CELL_PATH))
-                    {
-                        adjacentToPath = true;
-                        break;
-                    }
-                }
-
-                if ((connectsNetworks || adjacentToPath) &&
+                /* Only place path cells that truly connect corridor networks!
+                 * Cells that just run alongside the network we're already in would use up
+                 * our MAX_NEW_PATH_CELLS budget without connecting anything new.
+                 */
+                if (ConnectsDistinctCorridors(regions, grid, current.x, current.y, newX, newY, i) &&
                     IsValidPathPlacement(grid, newX, newY))
                 {
                     usePosition = true;
@@ -437,6 +439,7 @@ static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
     }
 
     // No path found within constraints
+    TRACE_END(searchZone);
     return false;
 }
 
@@ -446,11 +449,12 @@ static bool FindPathBetweenDoors(int grid[GRID_HEIGHT][GRID_WIDTH],
  */
 static bool FindPathWithFallbacks(int grid[GRID_HEIGHT][GRID_WIDTH],
                                  Corridor startDoor, int endDoorX, int endDoorY,
-                                 Corridor* queue, bool* visited, Corridor* previous)
+                                 Corridor* queue, bool* visited, Corridor* previous,
+                                 CorridorRegions* regions, GenerationStats* stats)
 {
     int temporaryLimit = MAX_NEW_PATH_CELLS;
 
-    if (FindPathBetweenDoors(grid, startDoor, endDoorX, endDoorY, queue, visited, previous))
+    if (FindPathBetweenDoors(grid, startDoor, endDoorX, endDoorY, queue, visited, previous, regions, stats))
     {
         return true;
     }
@@ -462,11 +466,12 @@ static bool FindPathWithFallbacks(int grid[GRID_HEIGHT][GRID_WIDTH],
     {
         // Temporarily increase the path limit
         temporaryLimit = newLimit;
+        stats->pathFallbackEscalations++;
 
-        if (FindPathBetweenDoors(grid, startDoor, endDoorX, endDoorY, queue, visited, previous))
+        if (FindPathBetweenDoors(grid, startDoor, endDoorX, endDoorY, queue, visited, previous, regions, stats))
         {
-            printf("Connected using fallback attempt %d (limit: %d path cells)\n",
-                   attempts, newLimit);
+            GAME_LOG_DEBUG("Connected using fallback attempt %d (limit: %d path cells)",
+                           attempts, newLimit);
 
             // Restore original limit
             temporaryLimit = MAX_NEW_PATH_CELLS;
@@ -493,7 +498,8 @@ static bool FindPathWithFallbacks(int grid[GRID_HEIGHT][GRID_WIDTH],
  * must traverse through the dungeon to reach it, but, it can still be otherwise traversed to.
  * It might make it more inconvenient at best but it's simply for the pathfinding algorithm itself.
  */
-void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount, int startRoomIndex, int bossRoomIndex)
+void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount, int startRoomIndex, int bossRoomIndex,
+                   CorridorRegions* regions, GenerationStats* stats)
 {
     bool* connected;
     Corridor* queue;
@@ -568,7 +574,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                             Corridor tryDoor = (Corridor) { tryDoorX, tryDoorY };
 
                             if (FindPathWithFallbacks(grid, tryDoor, targetDoorX, targetDoorY,
-                                queue, visited, previous))
+                                queue, visited, previous, regions, stats))
                             {
                                 // Mark the path
                                 int currentX = targetDoorX;
@@ -583,7 +589,9 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                                     if (grid[currentY][currentX] != CELL_DOOR &&
                                         grid[currentY][currentX] != CELL_CORRIDOR)
                                     {
+                                        stats->pathCellsPlaced += (grid[currentY][currentX] != CELL_PATH); // Only count new cells
                                         grid[currentY][currentX] = CELL_PATH;
+                                        AddRegionCell(regions, currentX, currentY);
                                     }
 
                                     prev = previous[GET_GRID_INDEX(currentX, currentY)];
@@ -591,7 +599,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                                     currentY = prev.y;
                                 }
 
-                                printf("Connected room %d to room %d (retry path)\n", tryRoom, targetRoom);
+                                GAME_LOG_DEBUG("Connected room %d to room %d (retry path)", tryRoom, targetRoom);
                                 currentRoom = targetRoom;
                                 currentDoor = (Corridor){targetDoorX, targetDoorY};
                                 connected[targetRoom] = true;
@@ -607,7 +615,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
 
             if (!foundNewPath)
             {
-                printf("Failed to connect all rooms! Connected: %d/%d\n", roomsConnected, roomCount);
+                GAME_LOG_WARN("Failed to connect all rooms! Connected: %d/%d", roomsConnected, roomCount);
                 break;
             }
         }
@@ -618,7 +626,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
             if (FindDoorPosition(grid, rooms[nextRoom], &nextDoorX, &nextDoorY))
             {
                 if (FindPathWithFallbacks(grid, currentDoor, nextDoorX, nextDoorY,
-                    queue, visited, previous))
+                    queue, visited, previous, regions, stats))
                 {
                     // Mark the path
                     int currentX = nextDoorX;
@@ -633,7 +641,9 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                         if (grid[currentY][currentX] != CELL_DOOR &&
                             grid[currentY][currentX] != CELL_CORRIDOR)
                         {
+                            stats->pathCellsPlaced += (grid[currentY][currentX] != CELL_PATH); // Only count new cells
                             grid[currentY][currentX] = CELL_PATH;
+                            AddRegionCell(regions, currentX, currentY);
                         }
 
                         prev = previous[GET_GRID_INDEX(currentX, currentY)];
@@ -641,7 +651,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                         currentY = prev.y;
                     }
 
-                    printf("Connected room %d to room %d\n", currentRoom, nextRoom);
+                    GAME_LOG_DEBUG("Connected room %d to room %d", currentRoom, nextRoom);
                     currentDoor = (Corridor){nextDoorX, nextDoorY};
                     connected[nextRoom] = true;
                     roomsConnected++;
@@ -651,7 +661,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                 {
                     // If we can't connect to closest room even with fallbacks,
                     // skip it temporarily
-                    printf("Could not connect to room %d - will try alternative paths\n", nextRoom);
+                    GAME_LOG_DEBUG("Could not connect to room %d - will try alternative paths", nextRoom);
                     connected[nextRoom] = true;  // Mark as "handled" but not truly connected yet
                     roomsConnected++;
                 }
@@ -675,7 +685,7 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
 
             // Try to connect the boss room
             if (FindPathWithFallbacks(grid, lastDoor, bossDoorX, bossDoorY,
-                queue, visited, previous))
+                queue, visited, previous, regions, stats))
             {
                 int currentX = bossDoorX;
                 int currentY = bossDoorY;
@@ -689,7 +699,9 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                     if (grid[currentY][currentX] != CELL_DOOR &&
                         grid[currentY][currentX] != CELL_CORRIDOR)
                     {
+                        stats->pathCellsPlaced += (grid[currentY][currentX] != CELL_PATH); // Only count new cells
                         grid[currentY][currentX] = CELL_PATH;
+                        AddRegionCell(regions, currentX, currentY);
                     }
 
                     prev = previous[GET_GRID_INDEX(currentX, currentY)];
@@ -697,12 +709,12 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
                     currentY = prev.y;
                 }
 
-                printf("Connected final room to boss room %d\n", bossRoomIndex);
+                GAME_LOG_DEBUG("Connected final room to boss room %d", bossRoomIndex);
                 connected[bossRoomIndex] = true;
             }
             else
             {
-                printf("Failed to connect boss room!\n");
+                GAME_LOG_WARN("Failed to connect boss room!");
             }
         }
     }
@@ -714,14 +726,14 @@ void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCoun
     {
         if (!connected[i])
         {
-            printf("Room %d is not connected!\n", i);
+            GAME_LOG_WARN("Room %d is not connected!", i);
             allConnected = false;
         }
     }
 
     if (!allConnected)
     {
-        printf("ERROR: Not all rooms are connected after pathfinding!\n");
+        GAME_LOG_ERROR("Not all rooms are connected after pathfinding!");
     }
 
     // Free memory
@@ -8,7 +8,9 @@ Player InitPlayer(int x, int y, int width, int height, Color color)
         y,
         width,
         height,
-        color
+        color,
+        SPEED_NORMAL,
+        ACTION_ENERGY  // Ready to go
     };
 
     return player;
@@ -20,60 +22,32 @@ void UpdatePlayerPosition(Player* player, int x, int y)
     player->y = y;
 }
 
-bool IsValidPlayerPosition(int gridData[GRID_HEIGHT][GRID_WIDTH], int x, int y)
+/* A single bit test on the floor's walkable mask, the masks are built from the grid when the floor is generated.
+ * Then one load from the occupancy index, nobody gets to walk through a monster!
+ */
+bool IsValidPlayerPosition(const FloorMasks* masks, const EntityStore* entities, int x, int y)
 {
-    if (!IS_IN_GRID(x, y))
-    {
-        return false;
-    }
-
-    /* Get cell value at the specified position */
-    const int cellValue = gridData[y][x];
-
-    return (IS_ROOM(cellValue) ||
-            cellValue == CELL_CORRIDOR ||
-            cellValue == CELL_PATH ||
-            cellValue == CELL_DOOR ||
-            cellValue == CELL_STAIR_UP ||
-            cellValue == CELL_STAIR_DOWN);
+    return IsWalkable(masks, x, y) && GetOccupant(entities, x, y) == ENTITY_NONE;
 }
 
-bool HandleMovementInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
-                        int* targetX, int* targetY)
+bool HandleMovementInput(Player* player, const FloorMasks* masks, const EntityStore* entities,
+                         const GameInput* input, int* targetX, int* targetY)
 {
-    /* Current position */
-    *targetX = player->x;
-    *targetY = player->y;
-
-    if (IsKeyPressed(KEY_W) || IsKeyPressed(KEY_UP))
-    {
-        *targetY = player->y - 1;
-    }
-    else if (IsKeyPressed(KEY_S) || IsKeyPressed(KEY_DOWN))
-    {
-        *targetY = player->y + 1;
-    }
-
-    if (IsKeyPressed(KEY_A) || IsKeyPressed(KEY_LEFT))
-    {
-        *targetX = player->x - 1;
-    }
-    else if (IsKeyPressed(KEY_D) || IsKeyPressed(KEY_RIGHT))
-    {
-        *targetX = player->x + 1;
-    }
+    /* Current position, plus wherever the input wants to go */
+    *targetX = player->x + input->moveX;
+    *targetY = player->y + input->moveY;
 
     if (*targetX == player->x && *targetY == player->y)
     {
         return false;
     }
 
-    return IsValidPlayerPosition(gridData, *targetX, *targetY);
+    return IsValidPlayerPosition(masks, entities, *targetX, *targetY);
 }
 
-ActionType HandleAction(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH])
+ActionType HandleAction(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH], const GameInput* input)
 {
-    if (IsKeyPressed(KEY_SPACE))
+    if (input->useStairs)
     {
         int currentCell = gridData[player->y][player->x];
 
@@ -86,9 +60,10 @@ ActionType HandleAction(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH])
     return ACTION_NONE;
 }
 
-/* Our main input handler
+/* Our main input handler, the input can come from the keyboard or anything else that fills in a GameInput
  */
-bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
+bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH], const FloorMasks* masks,
+                      const EntityStore* entities, const GameInput* input,
                       ActionType* actionType, int* targetX, int* targetY)
 {
     // Default
@@ -97,7 +72,7 @@ bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
     *actionType = ACTION_NONE;
 
     // Action first
-    ActionType action = HandleAction(player, gridData);
+    ActionType action = HandleAction(player, gridData, input);
 
     if (action != ACTION_NONE)
     {
@@ -106,7 +81,7 @@ bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
     }
 
     // Movement second
-    if (HandleMovementInput(player, gridData, targetX, targetY))
+    if (HandleMovementInput(player, masks, entities, input, targetX, targetY))
     {
         *actionType = ACTION_MOVE;
         return true; // Valid movement
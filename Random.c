@@ -0,0 +1,69 @@
+﻿#include "Random.h"
+
+/* rprand's state before the first seed.
+ * raylib seeds in InitWindow, we don't, so main seeds from the clock itself.
+ */
+static uint64_t splitMixState = 0xAABBCCDD;
+static uint32_t xoshiroState[4] = { 0x96ea83c1, 0x218b21e5, 0xaa91febd, 0x976414d4 };
+
+static uint64_t NextSplitMix64(void)
+{
+    uint64_t z = (splitMixState += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+    return z ^ (z >> 31);
+}
+
+static uint32_t RotateLeft(uint32_t x, int bits)
+{
+    return (x << bits) | (x >> (32 - bits));
+}
+
+static uint32_t NextXoshiro128(void)
+{
+    const uint32_t result = RotateLeft(xoshiroState[1] * 5, 7) * 9;
+    const uint32_t t = xoshiroState[1] << 9;
+
+    xoshiroState[2] ^= xoshiroState[0];
+    xoshiroState[3] ^= xoshiroState[1];
+    xoshiroState[1] ^= xoshiroState[2];
+    xoshiroState[0] ^= xoshiroState[3];
+    xoshiroState[2] ^= t;
+    xoshiroState[3] = RotateLeft(xoshiroState[3], 11);
+
+    return result;
+}
+
+// Low halves for words 0 and 2, high halves for 1 and 3, exactly like rprand_set_seed
+void SeedRandom(unsigned int seed)
+{
+    splitMixState = seed;
+
+    xoshiroState[0] = (uint32_t)(NextSplitMix64() & 0xffffffff);
+    xoshiroState[1] = (uint32_t)(NextSplitMix64() >> 32);
+    xoshiroState[2] = (uint32_t)(NextSplitMix64() & 0xffffffff);
+    xoshiroState[3] = (uint32_t)(NextSplitMix64() >> 32);
+}
+
+/* A plain modulo like rprand_get_value, a little biased for huge ranges,
+ * but every recorded floor and replay depends on this exact sequence!
+ */
+int GetRandomInt(int min, int max)
+{
+    if (min > max)
+    {
+        const int swap = max;
+        max = min;
+        min = swap;
+    }
+
+    const uint32_t range = (uint32_t)max - (uint32_t)min + 1u;
+
+    if (range == 0)
+    {
+        return (int)NextXoshiro128(); // The whole int range, rprand would divide by zero here
+    }
+
+    return (int)((uint32_t)min + NextXoshiro128() % range);
+}
\ No newline at end of file
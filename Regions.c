@@ -0,0 +1,161 @@
+﻿#include "Regions.h"
+
+/* Here, we give every corridor, path and door cell its own set,
+ * then merge each cell with its east and south neighbours.
+ * Looking back west/north isn't needed, those pairs were already merged from the other side!
+ */
+void LabelCorridorRegions(CorridorRegions* regions, int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    regions->regionCount = 0;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            const int index = GET_GRID_INDEX(x, y);
+
+            regions->rank[index] = 0;
+
+            if (IS_REGION_CELL(grid[y][x]))
+            {
+                regions->parent[index] = index;
+                regions->regionCount++;
+            }
+            else
+            {
+                regions->parent[index] = REGION_NONE;
+            }
+        }
+    }
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (!IS_REGION_CELL(grid[y][x]))
+            {
+                continue;
+            }
+
+            if (x + 1 < GRID_WIDTH && IS_REGION_CELL(grid[y][x + 1]))
+            {
+                UnionRegions(regions, GET_GRID_INDEX(x, y), GET_GRID_INDEX(x + 1, y));
+            }
+
+            if (y + 1 < GRID_HEIGHT && IS_REGION_CELL(grid[y + 1][x]))
+            {
+                UnionRegions(regions, GET_GRID_INDEX(x, y), GET_GRID_INDEX(x, y + 1));
+            }
+        }
+    }
+}
+
+/* Call this after turning a cell into a corridor, path or door.
+ * The cell joins (and merges) every region it now touches!
+ */
+void AddRegionCell(CorridorRegions* regions, int x, int y)
+{
+    const int index = GET_GRID_INDEX(x, y);
+
+    if (regions->parent[index] == REGION_NONE)
+    {
+        regions->parent[index] = index;
+        regions->rank[index] = 0;
+        regions->regionCount++;
+    }
+
+    static const int offsetX[] = { 0, 1, 0, -1 };
+    static const int offsetY[] = { -1, 0, 1, 0 };
+
+    for (int i = 0; i < 4; i++)
+    {
+        const int neighbourX = x + offsetX[i];
+        const int neighbourY = y + offsetY[i];
+
+        // Anything with a parent is part of some region, rooms included once they've been added
+        if (IS_IN_GRID(neighbourX, neighbourY) &&
+            regions->parent[GET_GRID_INDEX(neighbourX, neighbourY)] != REGION_NONE)
+        {
+            UnionRegions(regions, index, GET_GRID_INDEX(neighbourX, neighbourY));
+        }
+    }
+}
+
+/* Rooms aren't corridor networks, but the connector stage needs them as regions too.
+ * Every room becomes one region, merged with whatever it already touches.
+ */
+void AddRoomRegions(CorridorRegions* regions, Room rooms[], int roomCount)
+{
+    for (int i = 0; i < roomCount; i++)
+    {
+        for (int y = rooms[i].y; y < rooms[i].y + rooms[i].height; y++)
+        {
+            for (int x = rooms[i].x; x < rooms[i].x + rooms[i].width; x++)
+            {
+                if (IS_IN_GRID(x, y))
+                {
+                    AddRegionCell(regions, x, y);
+                }
+            }
+        }
+    }
+}
+
+static int FindRoot(CorridorRegions* regions, int index)
+{
+    // Path halving, every cell we pass ends up pointing to its grandparent
+    while (regions->parent[index] != index)
+    {
+        regions->parent[index] = regions->parent[regions->parent[index]];
+        index = regions->parent[index];
+    }
+
+    return index;
+}
+
+// Returns the region of a cell, or REGION_NONE if it isn't part of any network
+int FindRegion(CorridorRegions* regions, int x, int y)
+{
+    if (!IS_IN_GRID(x, y))
+    {
+        return REGION_NONE;
+    }
+
+    const int index = GET_GRID_INDEX(x, y);
+
+    if (regions->parent[index] == REGION_NONE)
+    {
+        return REGION_NONE;
+    }
+
+    return FindRoot(regions, index);
+}
+
+// Union by rank, returns false if both cells were already in the same region
+bool UnionRegions(CorridorRegions* regions, int indexA, int indexB)
+{
+    int rootA = FindRoot(regions, indexA);
+    int rootB = FindRoot(regions, indexB);
+
+    if (rootA == rootB)
+    {
+        return false;
+    }
+
+    if (regions->rank[rootA] < regions->rank[rootB])
+    {
+        const int temp = rootA;
+        rootA = rootB;
+        rootB = temp;
+    }
+
+    regions->parent[rootB] = rootA;
+
+    if (regions->rank[rootA] == regions->rank[rootB])
+    {
+        regions->rank[rootA]++;
+    }
+
+    regions->regionCount--;
+    return true;
+}
\ No newline at end of file
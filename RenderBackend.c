@@ -0,0 +1,117 @@
+﻿#include "RenderBackend.h"
+#include <stddef.h>
+
+// Texture ids handed out to the game are slots in here, an id of 0 means the slot is free
+static Texture2D raylibTextures[RENDER_MAX_TEXTURES];
+
+/* Straight to raylib, the window decides how big a frame is
+ */
+static void RaylibBeginFrame(RenderBackend* backend, Color clearColor)
+{
+    backend->width = GetScreenWidth();
+    backend->height = GetScreenHeight();
+
+    BeginDrawing();
+    ClearBackground(clearColor);
+}
+
+static void RaylibEndFrame(RenderBackend* backend)
+{
+    (void)backend;
+    EndDrawing();
+}
+
+static void RaylibBeginCamera(RenderBackend* backend, Camera2D camera)
+{
+    (void)backend;
+    BeginMode2D(camera);
+}
+
+static void RaylibEndCamera(RenderBackend* backend)
+{
+    (void)backend;
+    EndMode2D();
+}
+
+static void RaylibDrawRectangle(RenderBackend* backend, int x, int y, int width, int height, Color color)
+{
+    (void)backend;
+    DrawRectangle(x, y, width, height, color);
+}
+
+static void RaylibDrawCircle(RenderBackend* backend, int centerX, int centerY, float radius, Color color)
+{
+    (void)backend;
+    DrawCircle(centerX, centerY, radius, color);
+}
+
+static void RaylibDrawText(RenderBackend* backend, const char* text, int x, int y, int fontSize, Color color)
+{
+    (void)backend;
+    DrawText(text, x, y, fontSize, color);
+}
+
+static int RaylibCreateTexture(RenderBackend* backend, int width, int height)
+{
+    (void)backend;
+
+    for (int i = 0; i < RENDER_MAX_TEXTURES; i++)
+    {
+        if (raylibTextures[i].id == 0)
+        {
+            const Image image = GenImageColor(width, height, BLANK);
+
+            raylibTextures[i] = LoadTextureFromImage(image);
+            UnloadImage(image);
+
+            return (raylibTextures[i].id != 0) ? i : RENDER_NO_TEXTURE;
+        }
+    }
+
+    return RENDER_NO_TEXTURE;
+}
+
+static void RaylibUpdateTexture(RenderBackend* backend, int texture, int y, int rowCount, const Color* pixels)
+{
+    (void)backend;
+
+    const Texture2D target = raylibTextures[texture];
+    const Rectangle rows = { 0.0f, (float)y, (float)target.width, (float)rowCount };
+
+    UpdateTextureRec(target, rows, pixels);
+}
+
+static void RaylibDrawTexture(RenderBackend* backend, int texture, int x, int y, float scale, Color tint)
+{
+    (void)backend;
+    DrawTextureEx(raylibTextures[texture], (Vector2){ (float)x, (float)y }, 0.0f, scale, tint);
+}
+
+static void RaylibDestroyTexture(RenderBackend* backend, int texture)
+{
+    (void)backend;
+
+    UnloadTexture(raylibTextures[texture]);
+    raylibTextures[texture] = (Texture2D){ 0 };
+}
+
+RenderBackend CreateRaylibRenderBackend(void)
+{
+    const RenderBackend backend =
+    {
+        .context = NULL,
+        .beginFrame = RaylibBeginFrame,
+        .endFrame = RaylibEndFrame,
+        .beginCamera = RaylibBeginCamera,
+        .endCamera = RaylibEndCamera,
+        .drawRectangle = RaylibDrawRectangle,
+        .drawCircle = RaylibDrawCircle,
+        .drawText = RaylibDrawText,
+        .createTexture = RaylibCreateTexture,
+        .updateTexture = RaylibUpdateTexture,
+        .drawTexture = RaylibDrawTexture,
+        .destroyTexture = RaylibDestroyTexture
+    };
+
+    return backend;
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+﻿#include "RenderRecorder.h"
+#include "Log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RENDER_INITIAL_CAPACITY 1024
+
+RenderRecorder* CreateRenderRecorder(int frameWidth, int frameHeight)
+{
+    RenderRecorder* recorder = calloc(1, sizeof(RenderRecorder));
+
+    if (recorder == NULL)
+    {
+        GAME_LOG_ERROR("Render recorder allocation failed!");
+        return NULL;
+    }
+
+    recorder->commandCapacity = RENDER_INITIAL_CAPACITY;
+    recorder->commands = malloc(sizeof(RenderCommand) * recorder->commandCapacity);
+
+    if (recorder->commands == NULL)
+    {
+        GAME_LOG_ERROR("Render recorder allocation failed!");
+        free(recorder);
+        return NULL;
+    }
+
+    recorder->frameWidth = frameWidth;
+    recorder->frameHeight = frameHeight;
+
+    return recorder;
+}
+
+void DestroyRenderRecorder(RenderRecorder* recorder)
+{
+    if (recorder == NULL)
+    {
+        return;
+    }
+
+    free(recorder->commands);
+    free(recorder);
+}
+
+/* The next free command, the buffer doubles when it's full so a frame is never cut short.
+ * Only a failed grow drops the command!
+ */
+static RenderCommand* PushCommand(RenderBackend* backend, RenderCommandType type, Color color)
+{
+    RenderRecorder* recorder = backend->context;
+
+    if (recorder->commandCount == recorder->commandCapacity)
+    {
+        RenderCommand* grown = realloc(recorder->commands, sizeof(RenderCommand) * recorder->commandCapacity * 2);
+
+        if (grown == NULL)
+        {
+            GAME_LOG_ERROR("Render command buffer full at %d commands!", recorder->commandCount);
+            return NULL;
+        }
+
+        recorder->commands = grown;
+        recorder->commandCapacity *= 2;
+    }
+
+    RenderCommand* command = &recorder->commands[recorder->commandCount++];
+    command->type = (uint8_t)type;
+    command->color = color;
+    recorder->typeCounts[type]++;
+
+    return command;
+}
+
+static void RecordBeginFrame(RenderBackend* backend, Color clearColor)
+{
+    RenderRecorder* recorder = backend->context;
+
+    backend->width = recorder->frameWidth;
+    backend->height = recorder->frameHeight;
+
+    recorder->commandCount = 0;
+
+    RenderCommand* command = PushCommand(backend, RENDER_CLEAR, clearColor);
+
+    if (command != NULL)
+    {
+        command->x = command->y = 0;
+        command->width = recorder->frameWidth;
+        command->height = recorder->frameHeight;
+    }
+}
+
+static void RecordEndFrame(RenderBackend* backend)
+{
+    RenderRecorder* recorder = backend->context;
+
+    recorder->frameCount++;
+}
+
+static void RecordBeginCamera(RenderBackend* backend, Camera2D camera)
+{
+    RenderCommand* command = PushCommand(backend, RENDER_CAMERA, BLANK);
+
+    if (command != NULL)
+    {
+        command->x = (int)camera.target.x;
+        command->y = (int)camera.target.y;
+        command->width = (int)camera.offset.x;
+        command->height = (int)camera.offset.y;
+        command->scale = camera.zoom;
+    }
+}
+
+static void RecordEndCamera(RenderBackend* backend)
+{
+    PushCommand(backend, RENDER_CAMERA_END, BLANK);
+}
+
+static void RecordRectangle(RenderBackend* backend, int x, int y, int width, int height, Color color)
+{
+    RenderCommand* command = PushCommand(backend, RENDER_RECTANGLE, color);
+
+    if (command != NULL)
+    {
+        command->x = x;
+        command->y = y;
+        command->width = width;
+        command->height = height;
+    }
+}
+
+static void RecordCircle(RenderBackend* backend, int centerX, int centerY, float radius, Color color)
+{
+    RenderCommand* command = PushCommand(backend, RENDER_CIRCLE, color);
+
+    if (command != NULL)
+    {
+        command->x = centerX;
+        command->y = centerY;
+        command->width = (int)radius;
+        command->height = 0;
+    }
+}
+
+static void RecordText(RenderBackend* backend, const char* text, int x, int y, int fontSize, Color color)
+{
+    RenderCommand* command = PushCommand(backend, RENDER_TEXT, color);
+
+    if (command != NULL)
+    {
+        command->x = x;
+        command->y = y;
+        command->width = fontSize;
+        command->height = (int)strlen(text);
+
+        strncpy(command->text, text, RENDER_TEXT_SIZE - 1);
+        command->text[RENDER_TEXT_SIZE - 1] = '\0';
+    }
+}
+
+static int RecordCreateTexture(RenderBackend* backend, int width, int height)
+{
+    RenderRecorder* recorder = backend->context;
+    (void)height;
+
+    if (recorder->textureCount == RENDER_MAX_TEXTURES)
+    {
+        return RENDER_NO_TEXTURE;
+    }
+
+    recorder->textureWidths[recorder->textureCount] = width;
+
+    return recorder->textureCount++;
+}
+
+static void RecordUpdateTexture(RenderBackend* backend, int texture, int y, int rowCount, const Color* pixels)
+{
+    RenderRecorder* recorder = backend->context;
+    RenderCommand* command = PushCommand(backend, RENDER_TEXTURE_UPDATE, BLANK);
+    (void)pixels;
+
+    if (command != NULL)
+    {
+        command->x = texture;
+        command->y = y;
+        command->width = rowCount * recorder->textureWidths[texture] * (int)sizeof(Color);
+        command->height = rowCount;
+    }
+}
+
+static void RecordDrawTexture(RenderBackend* backend, int texture, int x, int y, float scale, Color tint)
+{
+    RenderCommand* command = PushCommand(backend, RENDER_TEXTURE, tint);
+
+    if (command != NULL)
+    {
+        command->x = x;
+        command->y = y;
+        command->width = texture;
+        command->scale = scale;
+    }
+}
+
+static void RecordDestroyTexture(RenderBackend* backend, int texture)
+{
+    (void)backend;
+    (void)texture;
+}
+
+RenderBackend CreateRecordingRenderBackend(RenderRecorder* recorder)
+{
+    const RenderBackend backend =
+    {
+        .context = recorder,
+        .width = recorder->frameWidth,
+        .height = recorder->frameHeight,
+        .beginFrame = RecordBeginFrame,
+        .endFrame = RecordEndFrame,
+        .beginCamera = RecordBeginCamera,
+        .endCamera = RecordEndCamera,
+        .drawRectangle = RecordRectangle,
+        .drawCircle = RecordCircle,
+        .drawText = RecordText,
+        .createTexture = RecordCreateTexture,
+        .updateTexture = RecordUpdateTexture,
+        .drawTexture = RecordDrawTexture,
+        .destroyTexture = RecordDestroyTexture
+    };
+
+    return backend;
+}
\ No newline at end of file
@@ -0,0 +1,449 @@
+﻿#include "Replay.h"
+#include "DungeonDefs.h"
+#include "Log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_INITIAL_INPUT_CAPACITY 4096
+#define REPLAY_INITIAL_SEED_CAPACITY 64
+#define VARINT_MAX_BYTES 10
+
+static Replay* AllocateReplay(ReplayMode mode)
+{
+    Replay* replay = calloc(1, sizeof(Replay));
+
+    if (replay == NULL)
+    {
+        GAME_LOG_ERROR("Replay allocation failed!");
+        return NULL;
+    }
+
+    replay->mode = mode;
+
+    return replay;
+}
+
+Replay* CreateReplayRecorder(void)
+{
+    Replay* replay = AllocateReplay(REPLAY_RECORDING);
+
+    if (replay == NULL)
+    {
+        return NULL;
+    }
+
+    replay->inputCapacity = REPLAY_INITIAL_INPUT_CAPACITY;
+    replay->inputs = malloc(replay->inputCapacity);
+    replay->seedCapacity = REPLAY_INITIAL_SEED_CAPACITY;
+    replay->seeds = malloc(sizeof(uint32_t) * replay->seedCapacity);
+
+    if (replay->inputs == NULL || replay->seeds == NULL)
+    {
+        GAME_LOG_ERROR("Replay allocation failed!");
+        DestroyReplay(replay);
+        return NULL;
+    }
+
+    return replay;
+}
+
+void DestroyReplay(Replay* replay)
+{
+    if (replay == NULL)
+    {
+        return;
+    }
+
+    free(replay->inputs);
+    free(replay->seeds);
+    free(replay);
+}
+
+// Doubles the input buffer until count more bytes fit, a failed grow truncates the recording
+static bool ReserveInputBytes(Replay* replay, size_t count)
+{
+    while (replay->inputSize + count > replay->inputCapacity)
+    {
+        uint8_t* grown = realloc(replay->inputs, replay->inputCapacity * 2);
+
+        if (grown == NULL)
+        {
+            GAME_LOG_ERROR("Replay input buffer full at %zu bytes, the rest of the session isn't recorded!",
+                           replay->inputSize);
+            replay->truncated = true;
+            return false;
+        }
+
+        replay->inputs = grown;
+        replay->inputCapacity *= 2;
+    }
+
+    return true;
+}
+
+// 7 bits at a time, low bits first, the top bit says another byte follows
+static size_t EncodeVarint(uint8_t* buffer, uint64_t value)
+{
+    size_t size = 0;
+
+    while (value >= 0x80)
+    {
+        buffer[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    buffer[size++] = (uint8_t)value;
+
+    return size;
+}
+
+static bool DecodeVarint(const uint8_t* buffer, size_t size, size_t* cursor, uint64_t* value)
+{
+    *value = 0;
+
+    for (int shift = 0; shift < 7 * VARINT_MAX_BYTES && *cursor < size; shift += 7)
+    {
+        const uint8_t byte = buffer[(*cursor)++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false; // Ran off the end, or a varint too long to be ours
+}
+
+static unsigned int EncodeInputCode(const GameInput* input)
+{
+    unsigned int code = (unsigned int)((input->moveY + 1) * 3 + input->moveX + 1);
+
+    code |= input->anyKey ? REPLAY_INPUT_ANY_KEY : 0;
+    code |= input->useStairs ? REPLAY_INPUT_USE_STAIRS : 0;
+    code |= input->explore ? REPLAY_INPUT_EXPLORE : 0;
+    code |= input->travel ? REPLAY_INPUT_TRAVEL : 0;
+    code |= input->regenerate ? REPLAY_INPUT_REGENERATE : 0;
+    code |= input->toggleTrace ? REPLAY_INPUT_TOGGLE_TRACE : 0;
+
+    return code;
+}
+
+static GameInput DecodeInputCode(unsigned int code)
+{
+    GameInput input = { 0 };
+    const int direction = (int)(code & REPLAY_INPUT_DIRECTION_MASK);
+
+    input.moveX = direction % 3 - 1;
+    input.moveY = direction / 3 - 1;
+    input.anyKey = (code & REPLAY_INPUT_ANY_KEY) != 0;
+    input.useStairs = (code & REPLAY_INPUT_USE_STAIRS) != 0;
+    input.explore = (code & REPLAY_INPUT_EXPLORE) != 0;
+    input.travel = (code & REPLAY_INPUT_TRAVEL) != 0;
+    input.regenerate = (code & REPLAY_INPUT_REGENERATE) != 0;
+    input.toggleTrace = (code & REPLAY_INPUT_TOGGLE_TRACE) != 0;
+
+    return input;
+}
+
+static void AppendInputRecord(Replay* replay, unsigned int code, const GameInput* input)
+{
+    if (replay->truncated || !ReserveInputBytes(replay, VARINT_MAX_BYTES * 4))
+    {
+        return;
+    }
+
+    uint8_t* out = replay->inputs;
+
+    replay->inputSize += EncodeVarint(out + replay->inputSize, replay->idleFrames);
+    replay->inputSize += EncodeVarint(out + replay->inputSize, code);
+
+    if (code & REPLAY_INPUT_TRAVEL)
+    {
+        replay->inputSize += EncodeVarint(out + replay->inputSize, (uint64_t)input->travelX);
+        replay->inputSize += EncodeVarint(out + replay->inputSize, (uint64_t)input->travelY);
+    }
+
+    replay->idleFrames = 0;
+}
+
+/* Call this every frame with the input UpdateGame is about to get.
+ * busy is whether the game does anything on an empty frame (generating a floor, travelling),
+ * only those empty frames are counted, everything else is skipped for free!
+ */
+void RecordReplayInput(Replay* replay, const GameInput* input, bool busy)
+{
+    const unsigned int code = EncodeInputCode(input);
+
+    if (code == REPLAY_INPUT_NO_DIRECTION)
+    {
+        replay->idleFrames += busy ? 1 : 0;
+        return;
+    }
+
+    AppendInputRecord(replay, code, input);
+}
+
+void RecordReplaySeed(Replay* replay, uint32_t seed)
+{
+    if (replay->truncated)
+    {
+        return;
+    }
+
+    if (replay->seedCount == replay->seedCapacity)
+    {
+        uint32_t* grown = realloc(replay->seeds, sizeof(uint32_t) * replay->seedCapacity * 2);
+
+        if (grown == NULL)
+        {
+            GAME_LOG_ERROR("Replay seed buffer full at %d seeds, the rest of the session isn't recorded!",
+                           replay->seedCount);
+            replay->truncated = true;
+            return;
+        }
+
+        replay->seeds = grown;
+        replay->seedCapacity *= 2;
+    }
+
+    replay->seeds[replay->seedCount++] = seed;
+}
+
+/* The next frame's input, false once the stream is over.
+ * Every record plays its idle frames (empty inputs) first, then the input itself.
+ */
+bool ReadReplayInput(Replay* replay, GameInput* input)
+{
+    *input = (GameInput){ 0 };
+
+    if (replay->idleFrames > 0)
+    {
+        replay->idleFrames--;
+        return true;
+    }
+
+    if (replay->hasPendingInput)
+    {
+        *input = replay->pendingInput;
+        replay->hasPendingInput = false;
+        return true;
+    }
+
+    if (replay->inputCursor == replay->inputSize)
+    {
+        return false;
+    }
+
+    uint64_t idleFrames, code, travelX = 0, travelY = 0;
+    bool valid = DecodeVarint(replay->inputs, replay->inputSize, &replay->inputCursor, &idleFrames) &&
+                 DecodeVarint(replay->inputs, replay->inputSize, &replay->inputCursor, &code);
+
+    if (valid && (code & REPLAY_INPUT_TRAVEL))
+    {
+        valid = DecodeVarint(replay->inputs, replay->inputSize, &replay->inputCursor, &travelX) &&
+                DecodeVarint(replay->inputs, replay->inputSize, &replay->inputCursor, &travelY);
+    }
+
+    if (!valid || (code & REPLAY_INPUT_DIRECTION_MASK) > 8 || idleFrames > UINT32_MAX)
+    {
+        GAME_LOG_ERROR("Corrupt replay input at byte %zu, stopping here!", replay->inputCursor);
+        replay->inputCursor = replay->inputSize;
+        return false;
+    }
+
+    replay->pendingInput = DecodeInputCode((unsigned int)code);
+    replay->pendingInput.travelX = (int)travelX;
+    replay->pendingInput.travelY = (int)travelY;
+    replay->hasPendingInput = true;
+    replay->idleFrames = (uint32_t)idleFrames;
+
+    return ReadReplayInput(replay, input);
+}
+
+bool ReadReplaySeed(Replay* replay, uint32_t* seed)
+{
+    if (replay->seedCursor == replay->seedCount)
+    {
+        return false;
+    }
+
+    *seed = replay->seeds[replay->seedCursor++];
+
+    return true;
+}
+
+/* The trailing idle frames (a session can end mid-travel) go in as one last empty record,
+ * then everything is written in one go, a session is only a few bytes per turn.
+ */
+bool SaveReplay(Replay* replay, const char* path, ReplayCheckpoint end)
+{
+    if (replay->mode != REPLAY_RECORDING)
+    {
+        return false;
+    }
+
+    // The empty record is itself one of the idle frames
+    if (replay->idleFrames > 0)
+    {
+        const GameInput empty = { 0 };
+
+        replay->idleFrames--;
+        AppendInputRecord(replay, REPLAY_INPUT_NO_DIRECTION, &empty);
+    }
+
+    if (replay->truncated)
+    {
+        GAME_LOG_WARN("Replay %s is truncated, it won't play back to the end of the session", path);
+    }
+
+    // Header, seeds and checkpoint are small, they're built in memory first
+    const size_t headerBound = sizeof(REPLAY_FILE_MAGIC) + VARINT_MAX_BYTES * (9 + (size_t)replay->seedCount);
+    uint8_t* header = malloc(headerBound);
+
+    if (header == NULL)
+    {
+        GAME_LOG_ERROR("Replay header allocation failed!");
+        return false;
+    }
+
+    size_t size = 0;
+    memcpy(header, REPLAY_FILE_MAGIC, 4);
+    size += 4;
+    size += EncodeVarint(header + size, REPLAY_FORMAT_VERSION);
+    size += EncodeVarint(header + size, GRID_WIDTH);
+    size += EncodeVarint(header + size, GRID_HEIGHT);
+    size += EncodeVarint(header + size, (uint64_t)replay->seedCount);
+
+    for (int i = 0; i < replay->seedCount; i++)
+    {
+        size += EncodeVarint(header + size, replay->seeds[i]);
+    }
+
+    size += EncodeVarint(header + size, end.turnCounter);
+    size += EncodeVarint(header + size, end.currentFloor);
+    size += EncodeVarint(header + size, end.playerX);
+    size += EncodeVarint(header + size, end.playerY);
+    size += EncodeVarint(header + size, replay->inputSize);
+
+    FILE* file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        GAME_LOG_ERROR("Could not create replay file %s!", path);
+        free(header);
+        return false;
+    }
+
+    bool success = fwrite(header, 1, size, file) == size &&
+                   fwrite(replay->inputs, 1, replay->inputSize, file) == replay->inputSize;
+
+    success = (fclose(file) == 0) && success;
+    free(header);
+
+    if (success)
+    {
+        GAME_LOG_INFO("Replay saved to %s: %d floor seeds, %zu input bytes",
+                      path, replay->seedCount, replay->inputSize);
+    }
+
+    return success;
+}
+
+static bool ParseReplay(Replay* replay, const uint8_t* data, size_t size)
+{
+    size_t cursor = 4;
+    uint64_t version, width, height, seedCount;
+
+    if (size < 4 || memcmp(data, REPLAY_FILE_MAGIC, 4) != 0 ||
+        !DecodeVarint(data, size, &cursor, &version) || version != REPLAY_FORMAT_VERSION ||
+        !DecodeVarint(data, size, &cursor, &width) || width != GRID_WIDTH ||
+        !DecodeVarint(data, size, &cursor, &height) || height != GRID_HEIGHT ||
+        !DecodeVarint(data, size, &cursor, &seedCount) || seedCount > size)
+    {
+        return false;
+    }
+
+    replay->seedCount = replay->seedCapacity = (int)seedCount;
+    replay->seeds = malloc(sizeof(uint32_t) * (seedCount > 0 ? seedCount : 1));
+
+    if (replay->seeds == NULL)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < replay->seedCount; i++)
+    {
+        uint64_t seed;
+
+        if (!DecodeVarint(data, size, &cursor, &seed) || seed > UINT32_MAX)
+        {
+            return false;
+        }
+
+        replay->seeds[i] = (uint32_t)seed;
+    }
+
+    uint64_t end[4], inputSize;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (!DecodeVarint(data, size, &cursor, &end[i]) || end[i] > UINT32_MAX)
+        {
+            return false;
+        }
+    }
+
+    if (!DecodeVarint(data, size, &cursor, &inputSize) || inputSize != size - cursor)
+    {
+        return false;
+    }
+
+    replay->end = (ReplayCheckpoint){ (uint32_t)end[0], (uint32_t)end[1], (uint32_t)end[2], (uint32_t)end[3] };
+    replay->inputSize = replay->inputCapacity = (size_t)inputSize;
+    replay->inputs = malloc(inputSize > 0 ? inputSize : 1);
+
+    if (replay->inputs == NULL)
+    {
+        return false;
+    }
+
+    memcpy(replay->inputs, data + cursor, inputSize);
+
+    return true;
+}
+
+Replay* LoadReplay(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        GAME_LOG_ERROR("Could not open replay file %s!", path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    uint8_t* data = (fileSize > 0) ? malloc((size_t)fileSize) : NULL;
+    Replay* replay = AllocateReplay(REPLAY_PLAYING);
+
+    const bool loaded = data != NULL && replay != NULL &&
+                        fread(data, 1, (size_t)fileSize, file) == (size_t)fileSize &&
+                        ParseReplay(replay, data, (size_t)fileSize);
+
+    fclose(file);
+    free(data);
+
+    if (!loaded)
+    {
+        GAME_LOG_ERROR("%s is not a valid replay file!", path);
+        DestroyReplay(replay);
+        return NULL;
+    }
+
+    return replay;
+}
\ No newline at end of file
@@ -1,4 +1,4 @@
-﻿#include <raylib.h>
+﻿#include "Random.h"
 #include "Dungeon.h"
 #include "Room.h"
 #include <stdlib.h>
@@ -78,10 +78,10 @@ static int CalculateRoomSize(int minPercent, int maxPercent, int minSize, int ma
     int minValue = minSize + ((range * minPercent) >> 7);  // Divide by 128 (~100) (100%)
     int maxValue = minSize + ((range * maxPercent) >> 7);
 
-    return GetRandomValue(minValue, maxValue);
+    return GetRandomInt(minValue, maxValue);
 }
 
-bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount)
+bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount, GenerationStats* stats)
 {
     *roomCount = 0;
     int nextRoomId = ROOM_ID_START;
@@ -122,10 +122,11 @@ bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCou
         // Try to place the room
         for (int attempt = 0; attempt < ATTEMPTS_PER_ROOM && !roomPlaced; attempt++)
         {
-            int x = GetRandomValue(ROOM_WIDTH_MIN_BOUND, ROOM_WIDTH_MAX_BOUND);
-            int y = GetRandomValue(ROOM_HEIGHT_MIN_BOUND, ROOM_HEIGHT_MAX_BOUND);
+            int x = GetRandomInt(ROOM_WIDTH_MIN_BOUND, ROOM_WIDTH_MAX_BOUND);
+            int y = GetRandomInt(ROOM_HEIGHT_MIN_BOUND, ROOM_HEIGHT_MAX_BOUND);
 
             Room room = CreateRoom(x, y, width, height);
+            stats->roomPlacementAttempts++;
 
             if (IsRoomValid(grid, room))
             {
@@ -136,6 +137,10 @@ bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCou
                 roomPlaced = true;
                 failedAttempts = 0;  // Reset failed attempts on success
             }
+            else
+            {
+                stats->roomPlacementRejections++;
+            }
         }
 
         failedAttempts += !roomPlaced;  // Increment if room wasn't placed (using bool to int conversion)
@@ -1,6 +1,6 @@
 ﻿#include "Staircase.h"
 #include "Room.h"
-#include <stdio.h>
+#include "Log.h"
 
 void PlaceStaircases(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount, int currentFloor)
 {
@@ -31,7 +31,7 @@ void PlaceStaircases(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCo
 
     if (startRoomIndex == -1 || bossRoomIndex == -1)
     {
-        printf("Error: Failed to find start or boss room indices!\n");
+        GAME_LOG_ERROR("Failed to find start or boss room indices!");
         return;
     }
     
@@ -42,17 +42,17 @@ void PlaceStaircases(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCo
     
     // Place the down staircase in boss room
     grid[bossY][bossX] = CELL_STAIR_DOWN;
-    printf("Placed down staircase at (%d, %d) in boss room\n", bossX, bossY);
+    GAME_LOG_DEBUG("Placed down staircase at (%d, %d) in boss room", bossX, bossY);
     
     // Place up staircase in start room, but only if not on first floor
     if (currentFloor > 1)
     {
         grid[startY][startX] = CELL_STAIR_UP;
-        printf("Placed up staircase at (%d, %d) in start room on floor %d\n", 
-               startX, startY, currentFloor);
+        GAME_LOG_DEBUG("Placed up staircase at (%d, %d) in start room on floor %d",
+                       startX, startY, currentFloor);
     }
     else
     {
-        printf("No up staircase placed on first floor\n");
+        GAME_LOG_DEBUG("No up staircase placed on first floor");
     }
 }
\ No newline at end of file
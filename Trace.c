@@ -0,0 +1,104 @@
+﻿#include "Trace.h"
+#include <stdio.h>
+#include "Clock.h"
+#include "Log.h"
+
+typedef struct TraceEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+} TraceEvent;
+
+/* NOTE: Recording isn't thread safe, everything we trace runs on the main thread.
+ * The buffer is static so recording never allocates.
+ */
+static TraceEvent events[TRACE_EVENT_CAPACITY];
+static int eventCount = 0;
+static int droppedEvents = 0;
+static bool tracing = false;
+static uint64_t traceStart = 0;
+
+void StartTracing(void)
+{
+    eventCount = 0;
+    droppedEvents = 0;
+    traceStart = GetClockNanoseconds();
+    tracing = true;
+}
+
+void StopTracing(void)
+{
+    tracing = false;
+}
+
+bool IsTracing(void)
+{
+    return tracing;
+}
+
+TraceZone BeginTraceZone(const char* name)
+{
+    TraceZone zone = { name, 0 };
+
+    if (tracing)
+    {
+        zone.start = GetClockNanoseconds();
+    }
+
+    return zone;
+}
+
+void EndTraceZone(TraceZone zone)
+{
+    // Zones that began before tracing was started have no start time, skip them
+    if (!tracing || zone.start == 0)
+    {
+        return;
+    }
+
+    if (eventCount >= TRACE_EVENT_CAPACITY)
+    {
+        droppedEvents++;
+        return;
+    }
+
+    TraceEvent* event = &events[eventCount++];
+    event->name = zone.name;
+    event->start = zone.start;
+    event->duration = GetClockNanoseconds() - zone.start;
+}
+
+/* Here, we write every event as a Chrome "complete" event (ph: X),
+ * which carries its own duration, so we never have to match begin/end pairs!
+ * Timestamps are in microseconds relative to StartTracing.
+ */
+bool DumpTrace(const char* path)
+{
+    FILE* file = fopen(path, "w");
+
+    if (file == NULL)
+    {
+        GAME_LOG_ERROR("Could not open %s for the trace!", path);
+        return false;
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+
+    for (int i = 0; i < eventCount; i++)
+    {
+        const TraceEvent* event = &events[i];
+        const uint64_t start = event->start >= traceStart ? event->start - traceStart : 0;
+
+        fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n",
+                event->name, (double)start / 1000.0, (double)event->duration / 1000.0,
+                (i + 1 < eventCount) ? "," : "");
+    }
+
+    fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    const bool success = fclose(file) == 0;
+
+    GAME_LOG_INFO("Wrote %d trace events to %s (%d dropped)", eventCount, path, droppedEvents);
+
+    return success;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+﻿#include "Travel.h"
+
+// Straight steps first, so travel doesn't zig-zag when it doesn't have to
+static const int travelDirX[] = { 0, 1, 0, -1, 1, 1, -1, -1 };
+static const int travelDirY[] = { -1, 0, 1, 0, -1, 1, 1, -1 };
+
+// The neighbour one step closer to the goal, false when we are on the goal or it can't be reached
+static bool FindDownhillStep(const DistanceMap* field, const FloorMasks* masks, int x, int y, int* stepX, int* stepY)
+{
+    const int distance = GetMapDistance(field, x, y);
+
+    if (distance == 0 || distance == DISTANCE_MAP_UNREACHABLE)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        const int newX = x + travelDirX[i];
+        const int newY = y + travelDirY[i];
+
+        if (IsWalkable(masks, newX, newY) && GetMapDistance(field, newX, newY) == distance - 1)
+        {
+            *stepX = newX;
+            *stepY = newY;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool StartTravel(TravelState* travel, const FloorMasks* masks, int fromX, int fromY, int targetX, int targetY)
+{
+    StopTravel(travel);
+
+    if (!IsWalkable(masks, targetX, targetY) || (fromX == targetX && fromY == targetY))
+    {
+        return false;
+    }
+
+    BuildDistanceMap(&travel->field, masks, targetX, targetY);
+
+    if (GetMapDistance(&travel->field, fromX, fromY) == DISTANCE_MAP_UNREACHABLE)
+    {
+        return false;
+    }
+
+    travel->mode = TRAVEL_TO_CELL;
+    travel->goalX = targetX;
+    travel->goalY = targetY;
+
+    return true;
+}
+
+/* Every walkable cell we haven't explored is a goal, so one multi-source build finds the nearest of them all.
+ * We then walk downhill once to find out which one that is, that's the cell we watch from now on!
+ */
+bool StartExplore(TravelState* travel, const FloorMasks* masks, const GridBits* explored, int fromX, int fromY)
+{
+    StopTravel(travel);
+
+    GridBits unexplored;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int word = 0; word < GRID_ROW_WORDS; word++)
+        {
+            unexplored.rows[y][word] = masks->walkable.rows[y][word] & ~explored->rows[y][word];
+        }
+    }
+
+    BuildDistanceMapFromMask(&travel->field, masks, &unexplored);
+
+    int x = fromX;
+    int y = fromY;
+
+    if (GetMapDistance(&travel->field, x, y) == DISTANCE_MAP_UNREACHABLE)
+    {
+        return false; // Nothing left we can get to
+    }
+
+    while (FindDownhillStep(&travel->field, masks, x, y, &x, &y))
+    {
+    }
+
+    travel->mode = TRAVEL_EXPLORE;
+    travel->goalX = x;
+    travel->goalY = y;
+
+    return true;
+}
+
+void StopTravel(TravelState* travel)
+{
+    travel->mode = TRAVEL_NONE;
+    travel->goalX = -1;
+    travel->goalY = -1;
+}
+
+/* The next cell to step on, or false once travel is over (StopTravel has then been called already).
+ * Exploring rebuilds its field here whenever the goal got explored along the way.
+ */
+bool NextTravelStep(TravelState* travel, const FloorMasks* masks, const GridBits* explored, int x, int y,
+                    int* stepX, int* stepY)
+{
+    if (travel->mode == TRAVEL_EXPLORE && GET_GRID_BIT(explored, travel->goalX, travel->goalY))
+    {
+        if (!StartExplore(travel, masks, explored, x, y))
+        {
+            return false;
+        }
+    }
+
+    if (travel->mode == TRAVEL_NONE || !FindDownhillStep(&travel->field, masks, x, y, stepX, stepY))
+    {
+        StopTravel(travel);
+        return false;
+    }
+
+    return true;
+}
\ No newline at end of file
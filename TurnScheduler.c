@@ -0,0 +1,167 @@
+﻿#include "TurnScheduler.h"
+#include <stdlib.h>
+#include "Log.h"
+
+TurnScheduler* CreateTurnScheduler(void)
+{
+    TurnScheduler* scheduler = malloc(sizeof(TurnScheduler));
+
+    if (scheduler == NULL)
+    {
+        GAME_LOG_ERROR("Turn scheduler allocation failed!");
+        return NULL;
+    }
+
+    ClearScheduler(scheduler);
+    return scheduler;
+}
+
+void DestroyTurnScheduler(TurnScheduler* scheduler)
+{
+    free(scheduler);
+}
+
+void ClearScheduler(TurnScheduler* scheduler)
+{
+    scheduler->now = 0;
+    scheduler->scheduledCount = 0;
+
+    for (int i = 0; i < SCHEDULE_BUCKETS; i++)
+    {
+        scheduler->head[i] = ACTOR_NONE;
+        scheduler->tail[i] = ACTOR_NONE;
+    }
+
+    for (int i = 0; i < ACTOR_COUNT; i++)
+    {
+        scheduler->bucketOf[i] = -1;
+    }
+}
+
+// The actor acts delay ticks from now, a delay of 0 means later this very tick
+void ScheduleActor(TurnScheduler* scheduler, int actor, int delay)
+{
+    if (actor < 0 || actor >= ACTOR_COUNT)
+    {
+        return;
+    }
+
+    if (delay < 0 || delay >= SCHEDULE_BUCKETS)
+    {
+        GAME_LOG_WARN("Actor %d scheduled %d ticks ahead, clamping", actor, delay);
+        delay = (delay < 0) ? 0 : SCHEDULE_BUCKETS - 1;
+    }
+
+    UnscheduleActor(scheduler, actor);
+
+    const int bucket = (int)((scheduler->now + delay) & (SCHEDULE_BUCKETS - 1));
+
+    scheduler->next[actor] = ACTOR_NONE;
+    scheduler->prev[actor] = scheduler->tail[bucket];
+
+    if (scheduler->tail[bucket] != ACTOR_NONE)
+    {
+        scheduler->next[scheduler->tail[bucket]] = actor;
+    }
+    else
+    {
+        scheduler->head[bucket] = actor;
+    }
+
+    scheduler->tail[bucket] = actor;
+    scheduler->bucketOf[actor] = (int16_t)bucket;
+    scheduler->scheduledCount++;
+}
+
+void UnscheduleActor(TurnScheduler* scheduler, int actor)
+{
+    if (actor < 0 || actor >= ACTOR_COUNT || scheduler->bucketOf[actor] < 0)
+    {
+        return;
+    }
+
+    const int bucket = scheduler->bucketOf[actor];
+    const int next = scheduler->next[actor];
+    const int prev = scheduler->prev[actor];
+
+    if (prev != ACTOR_NONE)
+    {
+        scheduler->next[prev] = next;
+    }
+    else
+    {
+        scheduler->head[bucket] = next;
+    }
+
+    if (next != ACTOR_NONE)
+    {
+        scheduler->prev[next] = prev;
+    }
+    else
+    {
+        scheduler->tail[bucket] = prev;
+    }
+
+    scheduler->bucketOf[actor] = -1;
+    scheduler->scheduledCount--;
+}
+
+// Moves time forward to the next tick anyone acts on, and tells us who goes first
+int PeekNextActor(TurnScheduler* scheduler)
+{
+    if (scheduler->scheduledCount == 0)
+    {
+        return ACTOR_NONE;
+    }
+
+    while (scheduler->head[scheduler->now & (SCHEDULE_BUCKETS - 1)] == ACTOR_NONE)
+    {
+        scheduler->now++;
+    }
+
+    return scheduler->head[scheduler->now & (SCHEDULE_BUCKETS - 1)];
+}
+
+int PopNextActor(TurnScheduler* scheduler)
+{
+    const int actor = PeekNextActor(scheduler);
+
+    UnscheduleActor(scheduler, actor);
+    return actor;
+}
+
+/* Call this when an actor has acted, with the energy it had banked.
+ * Returns how many ticks it has to wait to get ACTION_ENERGY back, the energy it will have by then is
+ * written back right away, so whatever is left over carries into the next turn!
+ */
+int SpendActionEnergy(int32_t* energy, int speed)
+{
+    if (speed < SPEED_MIN)
+    {
+        speed = SPEED_MIN;
+    }
+    else if (speed > SPEED_MAX)
+    {
+        speed = SPEED_MAX;
+    }
+
+    *energy -= ACTION_ENERGY;
+
+    if (*energy >= 0)
+    {
+        // Fast actors can have enough banked to go again this tick
+        if (*energy >= ACTION_ENERGY)
+        {
+            return 0;
+        }
+    }
+    else
+    {
+        *energy = 0;
+    }
+
+    const int ticks = (ACTION_ENERGY - *energy + speed - 1) / speed;
+    *energy += ticks * speed;
+
+    return ticks;
+}
\ No newline at end of file
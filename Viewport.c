@@ -0,0 +1,69 @@
+﻿#include "Viewport.h"
+#include <math.h>
+
+// The middle of the cell sits in the middle of the frame
+Camera2D GetFollowCamera(int cellX, int cellY, float zoom, int frameWidth, int frameHeight)
+{
+    const Camera2D camera =
+    {
+        .offset = { frameWidth * 0.5f, frameHeight * 0.5f },
+        .target = { cellX * CELL_SIZE + CELL_SIZE * 0.5f, cellY * CELL_SIZE + CELL_SIZE * 0.5f },
+        .rotation = 0.0f,
+        .zoom = zoom
+    };
+
+    return camera;
+}
+
+/* The frame corners back in world space, then in cells, clamped to the grid.
+ * Our camera never rotates, so the visible area is always an axis aligned rectangle!
+ */
+TileRect GetVisibleTiles(const Camera2D* camera, int frameWidth, int frameHeight)
+{
+    const float left = camera->target.x - camera->offset.x / camera->zoom;
+    const float top = camera->target.y - camera->offset.y / camera->zoom;
+    const float right = camera->target.x + (frameWidth - camera->offset.x) / camera->zoom;
+    const float bottom = camera->target.y + (frameHeight - camera->offset.y) / camera->zoom;
+
+    TileRect tiles =
+    {
+        (int)floorf(left / CELL_SIZE),
+        (int)floorf(top / CELL_SIZE),
+        (int)floorf(right / CELL_SIZE),
+        (int)floorf(bottom / CELL_SIZE)
+    };
+
+    tiles.minX = (tiles.minX < 0) ? 0 : tiles.minX;
+    tiles.minY = (tiles.minY < 0) ? 0 : tiles.minY;
+    tiles.maxX = (tiles.maxX >= GRID_WIDTH) ? GRID_WIDTH - 1 : tiles.maxX;
+    tiles.maxY = (tiles.maxY >= GRID_HEIGHT) ? GRID_HEIGHT - 1 : tiles.maxY;
+
+    return tiles;
+}
+
+// The cell under a point on the screen, false when that's off the grid
+bool ScreenToGridCell(const Camera2D* camera, Vector2 screen, int* cellX, int* cellY)
+{
+    const float worldX = (screen.x - camera->offset.x) / camera->zoom + camera->target.x;
+    const float worldY = (screen.y - camera->offset.y) / camera->zoom + camera->target.y;
+
+    *cellX = (int)floorf(worldX / CELL_SIZE);
+    *cellY = (int)floorf(worldY / CELL_SIZE);
+
+    return IS_IN_GRID(*cellX, *cellY);
+}
+
+float ApplyZoomSteps(float zoom, int steps)
+{
+    for (; steps > 0; steps--)
+    {
+        zoom *= CAMERA_ZOOM_STEP;
+    }
+
+    for (; steps < 0; steps++)
+    {
+        zoom /= CAMERA_ZOOM_STEP;
+    }
+
+    return (zoom < CAMERA_ZOOM_MIN) ? CAMERA_ZOOM_MIN : (zoom > CAMERA_ZOOM_MAX) ? CAMERA_ZOOM_MAX : zoom;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+﻿#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+/* A monotonic high resolution clock.
+ * raylib's GetTime() needs a window, this one works anywhere (tools, headless runs)!
+ */
+uint64_t GetClockNanoseconds(void);
+
+#endif // CLOCK_H
\ No newline at end of file
@@ -0,0 +1,16 @@
+﻿#ifndef CONNECTORS_H
+#define CONNECTORS_H
+
+#include <stdbool.h>
+#include "DungeonDefs.h"
+#include "Room.h"
+#include "Regions.h"
+#include "GenerationStats.h"
+
+// Connector Constants
+#define MAX_CONNECTOR_LENGTH 3 // Empty cells a connector may bridge, matches the door search distance
+
+bool ConnectRegions(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount,
+                    CorridorRegions* regions, GenerationStats* stats);
+
+#endif // CONNECTORS_H
\ No newline at end of file
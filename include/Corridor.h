@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "DungeonDefs.h"
+#include "GenerationStats.h"
 
 // Complete Corridor struct definition
 typedef struct Corridor {
@@ -18,7 +19,7 @@ typedef enum {
 } Direction;
 
 bool IsValidCorridorCell(int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y);
-void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int startY);
-void GenerateMazes(int grid[GRID_HEIGHT][GRID_WIDTH]);
+void RandomizedFloodFill(int grid[GRID_HEIGHT][GRID_WIDTH], int startX, int startY, GenerationStats* stats);
+void GenerateMazes(int grid[GRID_HEIGHT][GRID_WIDTH], GenerationStats* stats);
 
 #endif // CORRIDOR_H
\ No newline at end of file
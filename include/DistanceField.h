@@ -0,0 +1,22 @@
+﻿#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include <limits.h>
+#include "DungeonDefs.h"
+
+/* Distance from every empty cell to the nearest corridor, path or door, walking only through empty cells.
+ * One multi-source BFS builds the whole field, and placing new corridor cells only ever makes
+ * distances shorter, so keeping it up to date is a small BFS from just the new cells!
+ */
+#define DISTANCE_UNREACHABLE INT_MAX
+
+typedef struct DistanceField {
+    int distance[GRID_SIZE];
+    int queue[GRID_SIZE];  // Scratch space for the BFS, every cell is queued at most once
+} DistanceField;
+
+void BuildCorridorDistanceField(DistanceField* field, int grid[GRID_HEIGHT][GRID_WIDTH]);
+void RelaxDistanceField(DistanceField* field, int grid[GRID_HEIGHT][GRID_WIDTH], const int sources[], int sourceCount);
+int GetFieldDistance(const DistanceField* field, int x, int y);
+
+#endif // DISTANCEFIELD_H
\ No newline at end of file
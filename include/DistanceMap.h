@@ -0,0 +1,29 @@
+﻿#ifndef DISTANCEMAP_H
+#define DISTANCEMAP_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include "DungeonDefs.h"
+#include "GridBits.h"
+
+/* Number of turns from one source cell to every walkable cell, moving like the player does (diagonals included).
+ * The game keeps one from the player and one from each staircase, and everything that wants to know
+ * "how far is it" (auto-explore, monsters, difficulty tuning) reads those instead of searching on its own!
+ */
+#define DISTANCE_MAP_UNREACHABLE INT_MAX
+
+typedef struct DistanceMap {
+    int distance[GRID_SIZE];
+    int queue[GRID_SIZE];  // Scratch space, every cell is queued at most once per build or move
+    int sourceX;
+    int sourceY;           // -1 when the map has no source (e.g. no up staircase on the first floor)
+} DistanceMap;
+
+void BuildDistanceMap(DistanceMap* map, const FloorMasks* masks, int sourceX, int sourceY);
+void BuildDistanceMapFromMask(DistanceMap* map, const FloorMasks* masks, const GridBits* sources);
+int SettleDistanceMap(DistanceMap* map, const FloorMasks* masks, const int order[], int orderCount, int ceiling);
+void ClearDistanceMap(DistanceMap* map);
+void MoveDistanceMapSource(DistanceMap* map, const FloorMasks* masks, int sourceX, int sourceY);
+int GetMapDistance(const DistanceMap* map, int x, int y);
+
+#endif // DISTANCEMAP_H
\ No newline at end of file
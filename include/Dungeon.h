@@ -4,11 +4,21 @@
 #include <stdbool.h>
 #include "DungeonDefs.h"
 #include "Room.h"
+#include "GenerationStats.h"
+#include "GridBits.h"
+#include "RenderBackend.h"
+#include "Viewport.h"
 
 // Core dungeon functions
 void GenerateGrid(int grid[GRID_HEIGHT][GRID_WIDTH]);
 bool GenerateDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], int maxAttempts, int currentFloor,
-                     Room rooms[], int* roomCount);
-void PrintDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount);
+                     Room rooms[], int* roomCount, GenerationStats* stats);
+bool GenerateSeededDungeon(int grid[GRID_HEIGHT][GRID_WIDTH], unsigned int seed, int maxAttempts,
+                           int currentFloor, Room rooms[], int* roomCount, int* attemptsUsed,
+                           GenerationStats* stats);
+Color GetCellColour(int cell);
+Color FadeColour(Color colour, float alpha);
+void PrintDungeon(RenderBackend* render, const TileRect* tiles, const int grid[GRID_HEIGHT][GRID_WIDTH],
+                  const Room rooms[], int roomCount, const GridBits* explored, const GridBits* visible);
 
 #endif //DUNGEON_H
\ No newline at end of file
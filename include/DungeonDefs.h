@@ -19,8 +19,13 @@
 
 // General
 // The Height and Width should be an ODD number
+// Benchmarks can build with a bigger grid (-DGRID_WIDTH=...), the game and floor packs always use 69x69!
+#ifndef GRID_HEIGHT
 #define GRID_HEIGHT 69
+#endif
+#ifndef GRID_WIDTH
 #define GRID_WIDTH 69
+#endif
 #define CELL_SIZE 15
 #define GRID_TOTAL_HEIGHT (GRID_HEIGHT * CELL_SIZE)
 #define GRID_TOTAL_WIDTH (GRID_WIDTH * CELL_SIZE)
@@ -33,11 +38,48 @@
 #define CENTER_SCREEN_Y(height) ((GetScreenHeight() - (height)) >> 1)
 
 #define IS_IN_GRID(x, y) ((x) >= 0 && (x) < GRID_WIDTH && (y) >= 0 && (y) < GRID_HEIGHT)
-#define IS_ROOM(cell) ((cell) >= ROOM_ID_START)
-#define IS_EMPTY(cell) ((cell) == CELL_EMPTY_1 || (cell) == CELL_EMPTY_2)
-
 #define GET_GRID_INDEX(x, y) ((y) * GRID_WIDTH + (x))
 #define IS_VALID_CELL(x, y) ((x) >= 1 && (x) < GRID_WIDTH - 1 && (y) >= 1 && (y) < GRID_HEIGHT - 1)
-#define CAN_BE_PATH(cell) ((cell) == CELL_CORRIDOR || (cell) == CELL_EMPTY_1 || (cell) == CELL_EMPTY_2)
+
+// Cell properties, one bit each
+#define CELL_FLAG_CARVEABLE (1u << 0) // Untouched rock, the maze and the connectors may dig here
+#define CELL_FLAG_PATHABLE  (1u << 1) // GeneratePaths may route through it
+#define CELL_FLAG_WALKABLE  (1u << 2) // The player and monsters can stand on it
+#define CELL_FLAG_OPAQUE    (1u << 3) // Blocks line of sight
+#define CELL_FLAG_ROOM      (1u << 4)
+#define CELL_FLAG_REGION    (1u << 5) // Corridor, path or door, part of a corridor region
+
+/* Everything we know about a cell code, in one place!
+ * X(code, flags, colour, glyph), the colour and glyph are only expanded by PrintDungeon,
+ * so this header doesn't need raylib. Every room id shares the ROOM_ID_START row.
+ */
+#define CELL_TYPE_TABLE(X) \
+    X(CELL_EMPTY_1,    CELL_FLAG_CARVEABLE | CELL_FLAG_PATHABLE | CELL_FLAG_OPAQUE, GRAY,     NULL) \
+    X(CELL_EMPTY_2,    CELL_FLAG_CARVEABLE | CELL_FLAG_PATHABLE | CELL_FLAG_OPAQUE, GRAY,     NULL) \
+    X(CELL_ROOM,       CELL_FLAG_OPAQUE,                                         BLANK,    NULL) \
+    X(CELL_CORRIDOR,   CELL_FLAG_PATHABLE | CELL_FLAG_WALKABLE | CELL_FLAG_REGION, DARKGRAY, NULL) \
+    X(CELL_DOOR,       CELL_FLAG_WALKABLE | CELL_FLAG_REGION,                    RED,      NULL) \
+    X(CELL_PATH,       CELL_FLAG_WALKABLE | CELL_FLAG_REGION,                    GREEN,    NULL) \
+    X(CELL_STAIR_UP,   CELL_FLAG_WALKABLE,                                       BLUE,     "<")  \
+    X(CELL_STAIR_DOWN, CELL_FLAG_WALKABLE,                                       PURPLE,   ">")  \
+    X(ROOM_ID_START,   CELL_FLAG_ROOM | CELL_FLAG_WALKABLE,                      BLACK,    NULL)
+
+// Codes 8 and 9 are unused, they get no flags and a BLANK colour
+#define CELL_TYPE_COUNT (ROOM_ID_START + 1)
+#define CELL_TYPE_INDEX(cell) ((cell) < ROOM_ID_START ? (cell) : ROOM_ID_START)
+
+// Defined in DungeonDefs.c from CELL_TYPE_TABLE
+extern const unsigned char cellFlags[CELL_TYPE_COUNT];
+
+// One load and a mask test, cell must not be negative
+#define CELL_HAS_FLAG(cell, flag) ((cellFlags[CELL_TYPE_INDEX(cell)] & (flag)) != 0)
+
+#define IS_ROOM(cell) CELL_HAS_FLAG(cell, CELL_FLAG_ROOM)
+#define IS_EMPTY(cell) CELL_HAS_FLAG(cell, CELL_FLAG_CARVEABLE)
+#define CAN_BE_PATH(cell) CELL_HAS_FLAG(cell, CELL_FLAG_PATHABLE)
+#define IS_OPAQUE(cell) CELL_HAS_FLAG(cell, CELL_FLAG_OPAQUE)
+
+// Anything the player can stand on, BuildFloorMasks and the floor validator both use this!
+#define IS_WALKABLE(cell) CELL_HAS_FLAG(cell, CELL_FLAG_WALKABLE)
 
 #endif // DUNGEONDEFS_H
\ No newline at end of file
@@ -0,0 +1,74 @@
+﻿#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "DungeonDefs.h"
+#include "GridBits.h"
+
+// Benchmarks can raise this with -DMAX_ENTITIES=...
+#ifndef MAX_ENTITIES
+#define MAX_ENTITIES 4096
+#endif
+#define ENTITY_NONE -1
+
+typedef enum {
+    ENTITY_MONSTER,  // Blocks its cell
+    ENTITY_ITEM,     // Lies on the floor, anything can stand on top of it
+} EntityKind;
+
+typedef enum {
+    AI_IDLE,
+    AI_HUNTING,
+    AI_FLEEING,
+} AiState;
+
+/* Every monster and item on the floor, stored column by column!
+ *
+ * A turn mostly walks one or two columns over every entity (all positions, all energy values...),
+ * so keeping each column in its own array means those loops only touch the bytes they need.
+ * An entity is just an index into the columns. Indices never move while the entity lives,
+ * removed slots go on a free list and get reused by the next spawn.
+ *
+ * The spatial index goes the other way, from cells to entities:
+ *  - occupant is the blocking entity (if any) on every cell, one load answers "can I step there?"
+ *  - every entity is also in its cell's list, threaded through cellNext/cellPrev, so "what is here?"
+ *    walks only the entities on that cell, items and monsters alike
+ *  - occupied has a bit for every cell with a non-empty list, radius queries skip empty rows and cells with it
+ */
+typedef struct EntityStore {
+    int highWater;   // Every entity index is below this, loops can stop here
+    int liveCount;
+
+    // Columns
+    int16_t x[MAX_ENTITIES];
+    int16_t y[MAX_ENTITIES];
+    int16_t health[MAX_ENTITIES];
+    int32_t energy[MAX_ENTITIES];
+    uint8_t speed[MAX_ENTITIES];    // Energy gained per tick, 0 for things that never act
+    uint8_t kind[MAX_ENTITIES];     // EntityKind
+    uint8_t aiState[MAX_ENTITIES];  // AiState
+    uint8_t alive[MAX_ENTITIES];
+
+    int freeSlots[MAX_ENTITIES];
+    int freeCount;
+
+    int occupant[GRID_SIZE];  // ENTITY_NONE when nothing blocks the cell
+    int cellHead[GRID_SIZE];  // First entity on the cell, ENTITY_NONE when there are none
+    int cellNext[MAX_ENTITIES];
+    int cellPrev[MAX_ENTITIES];
+    GridBits occupied;
+} EntityStore;
+
+EntityStore* CreateEntityStore(void);
+void DestroyEntityStore(EntityStore* store);
+void ClearEntities(EntityStore* store);
+
+int SpawnEntity(EntityStore* store, EntityKind kind, int x, int y, int health);
+void RemoveEntity(EntityStore* store, int entity);
+bool MoveEntity(EntityStore* store, int entity, int x, int y);
+int GetOccupant(const EntityStore* store, int x, int y);
+int GetFirstEntityAt(const EntityStore* store, int x, int y);
+int QueryEntitiesInRadius(const EntityStore* store, int x, int y, int radius, int results[], int maxResults);
+
+#endif // ENTITYSTORE_H
\ No newline at end of file
@@ -0,0 +1,12 @@
+﻿#ifndef FIELDOFVIEW_H
+#define FIELDOFVIEW_H
+
+#include "DungeonDefs.h"
+#include "GridBits.h"
+
+// How far the player can see, in cells (a circle, not a square!)
+#define FOV_RADIUS 12
+
+void ComputeFieldOfView(GridBits* visible, const GridBits* opaque, int originX, int originY, int radius);
+
+#endif // FIELDOFVIEW_H
\ No newline at end of file
@@ -0,0 +1,21 @@
+﻿#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* A read-only memory mapped file.
+ * The OS pages the file in on demand, so "opening" a huge file costs next to nothing!
+ */
+typedef struct MappedFile {
+    const uint8_t* data;
+    size_t size;
+    void* fileHandle;    // Platform handles, only used when unmapping
+    void* mappingHandle;
+} MappedFile;
+
+bool MapFileReadOnly(const char* path, MappedFile* file);
+void UnmapFile(MappedFile* file);
+
+#endif // FILEMAP_H
\ No newline at end of file
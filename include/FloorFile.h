@@ -0,0 +1,109 @@
+﻿#ifndef FLOORFILE_H
+#define FLOORFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "DungeonDefs.h"
+#include "Room.h"
+#include "FileMap.h"
+
+/* On-disk floor format (little endian, every struct naturally aligned)
+ *
+ * A floor file looks like this:
+ *   FloorFileHeader
+ *   uint32_t offsets[offsetCapacity]  -> byte offset of each floor record from the file start
+ *   FloorRecord, FloorRecord, ...     -> each record is padded to FLOOR_RECORD_ALIGNMENT
+ *
+ * And a single floor record looks like this:
+ *   FloorRecordHeader
+ *   FloorRoomEntry rooms[roomCount]
+ *   uint8_t runs[runBytes]            -> the grid as RLE pairs of (count, cell code)
+ *
+ * Because the layout is aligned, a mapped file can be read directly through pointers,
+ * no copying or parsing needed until we actually decode a floor into a grid!
+ */
+#define FLOOR_FILE_MAGIC "DRFF"
+#define FLOOR_FORMAT_VERSION 1
+#define FLOOR_RECORD_ALIGNMENT 8
+#define FLOOR_NO_STAIR (-1)
+
+// Record flags
+#define FLOOR_FLAG_CHECKER_EMPTY 1 // Empty cells were stored as CELL_EMPTY_1, restore the GenerateGrid pattern
+
+typedef struct FloorFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t recordAlignment;
+    uint32_t floorCount;
+    uint32_t offsetCapacity;
+} FloorFileHeader;
+
+typedef struct FloorRecordHeader {
+    uint32_t recordSize;  // Whole record including padding
+    uint32_t seed;
+    uint16_t floorNumber;
+    uint16_t gridWidth;
+    uint16_t gridHeight;
+    uint16_t roomCount;
+    int16_t stairUpX;
+    int16_t stairUpY;
+    int16_t stairDownX;
+    int16_t stairDownY;
+    uint32_t runBytes;
+    uint32_t flags;
+} FloorRecordHeader;
+
+typedef struct FloorRoomEntry {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint8_t type;
+    uint8_t padding[3];
+} FloorRoomEntry;
+
+// A read-only view into a record, the pointers point straight into the mapped file
+typedef struct FloorView {
+    const FloorRecordHeader* header;
+    const FloorRoomEntry* rooms;
+    const uint8_t* runs;
+} FloorView;
+
+// A mapped file of many floors
+typedef struct FloorFile {
+    MappedFile map;
+    const FloorFileHeader* header;
+    const uint32_t* offsets;
+} FloorFile;
+
+// Streaming writer, the offset table is reserved up front and patched in at the end
+typedef struct FloorFileWriter {
+    FILE* file;
+    uint32_t* offsets;
+    uint32_t floorCount;
+    uint32_t offsetCapacity;
+    uint32_t nextOffset;
+    uint8_t* scratch;
+} FloorFileWriter;
+
+// Encoding / decoding single records
+size_t GetFloorRecordBound(void);
+size_t EncodeFloorRecord(uint8_t* buffer, size_t capacity, int grid[GRID_HEIGHT][GRID_WIDTH],
+                         Room rooms[], int roomCount, unsigned int seed, int floorNumber);
+bool GetFloorRecordView(const uint8_t* data, size_t size, FloorView* view);
+bool DecodeFloorView(FloorView view, int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount);
+
+// Writing floor files
+bool BeginFloorFile(FloorFileWriter* writer, const char* path, int maxFloors);
+bool AppendFloor(FloorFileWriter* writer, int grid[GRID_HEIGHT][GRID_WIDTH],
+                 Room rooms[], int roomCount, unsigned int seed, int floorNumber);
+bool EndFloorFile(FloorFileWriter* writer);
+
+// Reading floor files
+bool OpenFloorFile(const char* path, FloorFile* floorFile);
+void CloseFloorFile(FloorFile* floorFile);
+bool GetFloorView(const FloorFile* floorFile, int index, FloorView* view);
+
+#endif // FLOORFILE_H
\ No newline at end of file
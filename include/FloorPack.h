@@ -0,0 +1,73 @@
+﻿#ifndef FLOORPACK_H
+#define FLOORPACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "FloorFile.h"
+
+/* A floor pack serves pre-baked floors by seed and floor number!
+ *
+ *   FloorPackHeader
+ *   FloorRecord, FloorRecord, ...     -> same records as FloorFile.h, RLE compressed
+ *   FloorPackEntry index[floorCount]  -> sorted by (seed, floor number), so lookups are a binary search
+ *
+ * The index lives at the end so the builder can stream records out without knowing
+ * how many floors will actually generate. Offsets are 64-bit, packs of millions of floors
+ * easily go past 4GB!
+ *
+ * One pack can hold any number of challenge runs: floor N of run s is generated from seed s + N - 1
+ * (see CHALLENGE_FLOOR_SEED), exactly the seed the game asks for when started with that pack and s.
+ * Neighbouring runs share seeds (run s floor 2 and run s + 1 floor 1 are both seed s + 1),
+ * but the generator also depends on the floor number, that's why the index is keyed by both!
+ */
+#define FLOOR_PACK_MAGIC "DRPK"
+#define FLOOR_PACK_VERSION 2 // 2: index keyed by (seed, floor number)
+
+// The seed of floor N in a challenge run, shared by FloorPackBuilder and the game so they can't drift apart
+#define CHALLENGE_FLOOR_SEED(challengeSeed, floorNumber) ((unsigned int)(challengeSeed) + (unsigned int)((floorNumber) - 1))
+
+typedef struct FloorPackHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t recordAlignment;
+    uint32_t floorCount;
+    uint32_t reserved;
+    uint64_t indexOffset;
+} FloorPackHeader;
+
+typedef struct FloorPackEntry {
+    uint64_t offset;
+    uint32_t seed;
+    uint32_t recordSize;
+    uint16_t floorNumber;
+    uint8_t padding[6];
+} FloorPackEntry;
+
+typedef struct FloorPack {
+    MappedFile map;
+    const FloorPackHeader* header;
+    const FloorPackEntry* index;
+} FloorPack;
+
+typedef struct FloorPackWriter {
+    FILE* file;
+    FloorPackEntry* entries;
+    uint32_t floorCount;
+    uint32_t capacity;
+    uint64_t nextOffset;
+    uint8_t* scratch;
+} FloorPackWriter;
+
+// Building packs (offline)
+bool BeginFloorPack(FloorPackWriter* writer, const char* path, int maxFloors);
+bool AddFloorToPack(FloorPackWriter* writer, int grid[GRID_HEIGHT][GRID_WIDTH],
+                    Room rooms[], int roomCount, unsigned int seed, int floorNumber);
+bool EndFloorPack(FloorPackWriter* writer);
+
+// Reading packs (in game)
+bool OpenFloorPack(const char* path, FloorPack* pack);
+void CloseFloorPack(FloorPack* pack);
+bool FindPackedFloor(const FloorPack* pack, unsigned int seed, int floorNumber, FloorView* view);
+
+#endif // FLOORPACK_H
\ No newline at end of file
@@ -0,0 +1,17 @@
+﻿#ifndef FLOORVALIDATOR_H
+#define FLOORVALIDATOR_H
+
+#include <stdint.h>
+#include "DungeonDefs.h"
+#include "Room.h"
+
+/* Bits 0 .. ROOM_AMOUNT - 1 are the rooms themselves (bit i => rooms[i] can't be reached),
+ * the top bits flag everything else we check. A result of FLOOR_REACHABLE means the floor is playable!
+ */
+#define FLOOR_REACHABLE 0u
+#define FLOOR_UNREACHABLE_DOOR (1u << 30)
+#define FLOOR_UNREACHABLE_STAIR_DOWN (1u << 31)
+
+uint32_t ValidateFloorConnectivity(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount);
+
+#endif // FLOORVALIDATOR_H
\ No newline at end of file
@@ -5,6 +5,19 @@
 #include "Room.h"
 #include "Corridor.h"
 #include "Player.h"
+#include "FloorPack.h"
+#include "GridBits.h"
+#include "DistanceMap.h"
+#include "Travel.h"
+#include "FieldOfView.h"
+#include "EntityStore.h"
+#include "TurnScheduler.h"
+#include "MonsterAi.h"
+#include "GameInput.h"
+#include "Replay.h"
+#include "RenderBackend.h"
+#include "Viewport.h"
+#include "Minimap.h"
 
 typedef struct
 {
@@ -12,24 +25,52 @@ typedef struct
     int screenHeight;
 
     int grid[GRID_HEIGHT][GRID_WIDTH];
+    FloorMasks masks; // Bit layers derived from grid, keep in sync with UpdateFloorMaskCell!
     bool dungeonGenerated;
     int generationAttempts;
+    GenerationStats generationStats; // Work done generating the current floor
 
     Corridor playerPos;
 
     // Rooms
     int currentFloor;
+    unsigned int floorSeed; // Seed the current floor was generated from
     bool transitioningFloors;
+
+    // Challenge runs: floors come from a pre-baked pack, floor N uses seed challengeSeed + N - 1
+    const FloorPack* floorPack;
+    unsigned int challengeSeed;
     Room rooms[ROOM_AMOUNT];
     int roomCount;
 
     Player player;
     int turnCounter;
+
+    // Shared by everything that needs distances, the player map follows every move
+    DistanceMap playerDistances;
+    DistanceMap stairUpDistances;
+    DistanceMap stairDownDistances;
+
+    GridBits visible;    // What the player can see right now, recomputed after every move
+    GridBits explored;   // Everything the player has seen on this floor
+    TravelState travel;  // Click-to-travel and auto-explore
+    float zoom;          // Camera zoom, the camera itself always follows the player
+
+    EntityStore* entities; // Monsters and items on this floor, on the heap
+    TurnScheduler* scheduler; // Who acts next, the player included
+    MonsterAi* ai;            // Shared flee map and per-turn AI counts
+    Minimap* minimap;         // Explored cells as a small texture, kept in sync by UpdatePlayerView
+
+    Replay* replay;           // Recording or playing back this session, NULL when neither
 } Game;
 
 Game InitGame(int width, int height);
-void UpdateGame(Game* game);
-void DrawGame(Game game);
+bool UpdateGame(Game* game, GameInput input); // True when the frame needs redrawing
+void DrawGame(const Game* game, RenderBackend* render);
+Camera2D GetGameCamera(const Game* game, int frameWidth, int frameHeight);
+void UnloadGame(Game* game);
+bool IsGameBusy(const Game* game);
+ReplayCheckpoint GetGameCheckpoint(const Game* game);
 
 // Floor transition helpers
 void GoDownStairs(Game* game);
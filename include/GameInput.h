@@ -0,0 +1,29 @@
+﻿#ifndef GAMEINPUT_H
+#define GAMEINPUT_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/* Everything UpdateGame reacts to in one frame!
+ *
+ * The game never asks raylib about keys itself, main.c reads the keyboard into one of these,
+ * and anything else (a scripted run, a random agent, a replay) can fill it in just the same.
+ * A zeroed GameInput means nothing was pressed.
+ */
+typedef struct GameInput {
+    int moveX;         // -1, 0 or 1
+    int moveY;         // -1, 0 or 1
+    bool useStairs;    // Space
+    bool explore;      // X
+    bool travel;       // Left click, travelX/travelY is the clicked grid cell
+    int travelX;
+    int travelY;
+    bool regenerate;   // G
+    bool toggleTrace;  // F9
+    int zoomSteps;     // Mouse wheel or +/-, positive zooms in
+    bool anyKey;       // Any key at all, interrupts travel
+} GameInput;
+
+GameInput ReadKeyboardInput(const Camera2D* camera);
+
+#endif // GAMEINPUT_H
\ No newline at end of file
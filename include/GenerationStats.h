@@ -0,0 +1,40 @@
+﻿#ifndef GENERATIONSTATS_H
+#define GENERATIONSTATS_H
+
+/* Work counters for a single generated floor!
+ * Wall time tells us how long a stage took, these tell us how much work it did,
+ * which is what we actually want to compare when changing an algorithm.
+ *
+ * Every generation step gets a pointer to this and simply increments the fields,
+ * no branches or function calls on the hot paths.
+ * They're 64-bit so batch tools can sum them over millions of floors.
+ */
+typedef struct GenerationStats {
+    // GenerateRooms
+    long long roomPlacementAttempts;
+    long long roomPlacementRejections;
+
+    // GenerateMazes
+    long long mazeFloodFillSeeds;
+    long long corridorCellsCarved;
+
+    // ConnectRoomsViaDoors
+    long long doorCorridorProbes;
+    long long doorFallbackPlacements;
+
+    // GeneratePaths / FindPathWithFallbacks
+    long long pathSearches;
+    long long pathNodesExpanded;
+    long long pathFallbackEscalations;
+    long long pathCellsPlaced;
+
+    // ConnectRegions (USE_CONNECTOR_STAGE)
+    long long connectorCandidates;
+    long long connectorsCarved;
+    long long connectorCellsPlaced;
+
+    // ValidateFloorConnectivity
+    long long floorsFailedValidation;
+} GenerationStats;
+
+#endif // GENERATIONSTATS_H
\ No newline at end of file
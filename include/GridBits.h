@@ -0,0 +1,39 @@
+﻿#ifndef GRIDBITS_H
+#define GRIDBITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "DungeonDefs.h"
+
+/* One bit per cell, packed into 64-bit words row by row!
+ *
+ * A whole row is GRID_ROW_WORDS words, so questions like "is anything in this row walkable"
+ * or "grow this region by one cell" become a handful of shifts and ANDs instead of a loop over cells.
+ * Bits past GRID_WIDTH in the last word of a row are always 0, row scans can rely on that.
+ */
+#define GRID_ROW_WORDS ((GRID_WIDTH + 63) / 64)
+
+typedef struct GridBits {
+    uint64_t rows[GRID_HEIGHT][GRID_ROW_WORDS];
+} GridBits;
+
+// No bounds checks, use IS_IN_GRID first where needed
+#define GET_GRID_BIT(bits, x, y) ((((bits)->rows[(y)][(x) >> 6]) >> ((x) & 63)) & 1u)
+#define SET_GRID_BIT(bits, x, y) ((bits)->rows[(y)][(x) >> 6] |= (uint64_t)1 << ((x) & 63))
+#define CLEAR_GRID_BIT(bits, x, y) ((bits)->rows[(y)][(x) >> 6] &= ~((uint64_t)1 << ((x) & 63)))
+
+/* The per-floor layers derived from the grid.
+ * Build them once per floor, then call UpdateFloorMaskCell whenever a cell changes!
+ */
+typedef struct FloorMasks {
+    GridBits walkable; // IS_WALKABLE, what the player and monsters can stand on
+    GridBits opaque;   // IS_OPAQUE, blocks line of sight
+} FloorMasks;
+
+void ClearGridBits(GridBits* bits);
+void OrGridBits(GridBits* bits, const GridBits* other);
+void BuildFloorMasks(FloorMasks* masks, int grid[GRID_HEIGHT][GRID_WIDTH]);
+void UpdateFloorMaskCell(FloorMasks* masks, int grid[GRID_HEIGHT][GRID_WIDTH], int x, int y);
+bool IsWalkable(const FloorMasks* masks, int x, int y);
+
+#endif // GRIDBITS_H
\ No newline at end of file
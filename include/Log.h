@@ -0,0 +1,57 @@
+﻿#ifndef LOG_H
+#define LOG_H
+
+/* Our logging facility!
+ *
+ * Messages are formatted into a per-thread ring buffer and written out by a background thread,
+ * so the generator and the game loop never wait on stdout.
+ *
+ * Anything below GAME_LOG_LEVEL is compiled out entirely, the arguments aren't even evaluated,
+ * which means a GAME_LOG_DEBUG in a hot loop costs nothing in a normal build.
+ */
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+// Override per target, e.g. -DGAME_LOG_LEVEL=LOG_LEVEL_DEBUG
+#ifndef GAME_LOG_LEVEL
+    #define GAME_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_MESSAGE_SIZE 128    // Longer messages are truncated
+#define LOG_RING_CAPACITY 1024  // Records per thread, must be a power of 2!
+
+#if GAME_LOG_LEVEL <= LOG_LEVEL_DEBUG
+    #define GAME_LOG_DEBUG(...) WriteLog(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+    #define GAME_LOG_DEBUG(...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= LOG_LEVEL_INFO
+    #define GAME_LOG_INFO(...) WriteLog(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+    #define GAME_LOG_INFO(...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= LOG_LEVEL_WARN
+    #define GAME_LOG_WARN(...) WriteLog(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+    #define GAME_LOG_WARN(...) ((void)0)
+#endif
+
+#if GAME_LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define GAME_LOG_ERROR(...) WriteLog(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+    #define GAME_LOG_ERROR(...) ((void)0)
+#endif
+
+// Until StartLogger is called (or after StopLogger), messages are written synchronously
+void StartLogger(void);
+void StopLogger(void);
+
+// Use the GAME_LOG_* macros instead, a newline is added for you
+void WriteLog(int level, const char* format, ...);
+
+#endif // LOG_H
\ No newline at end of file
@@ -0,0 +1,45 @@
+﻿#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "DungeonDefs.h"
+#include "GridBits.h"
+#include "RenderBackend.h"
+#include "Viewport.h"
+
+/* The whole floor in a corner of the screen, as one small texture!
+ *
+ * Every pixel is MINIMAP_SCALE x MINIMAP_SCALE cells, one cell per pixel on our floors and fewer pixels
+ * on huge ones, so the texture never gets bigger than MINIMAP_MAX_SIZE on a side.
+ * The pixels only change when cells get explored: UpdateMinimap writes just the newly explored cells and
+ * remembers which rows changed, and drawing uploads just those rows. Every other frame the minimap
+ * is a single textured quad.
+ */
+#define MINIMAP_MAX_SIZE 256
+#define MINIMAP_GRID_SIDE ((GRID_WIDTH > GRID_HEIGHT) ? GRID_WIDTH : GRID_HEIGHT)
+#define MINIMAP_SCALE ((MINIMAP_GRID_SIDE + MINIMAP_MAX_SIZE - 1) / MINIMAP_MAX_SIZE)
+#define MINIMAP_WIDTH ((GRID_WIDTH + MINIMAP_SCALE - 1) / MINIMAP_SCALE)
+#define MINIMAP_HEIGHT ((GRID_HEIGHT + MINIMAP_SCALE - 1) / MINIMAP_SCALE)
+
+// On screen, top right corner
+#define MINIMAP_SCREEN_SIZE 240
+#define MINIMAP_SCREEN_MARGIN 20
+
+typedef struct Minimap {
+    Color pixels[MINIMAP_WIDTH * MINIMAP_HEIGHT];
+    GridBits drawn;     // Explored cells already in pixels
+    int dirtyMinY;      // Pixel rows changed since the last upload, none when dirtyMinY > dirtyMaxY
+    int dirtyMaxY;
+    int texture;        // RENDER_NO_TEXTURE until the first draw
+} Minimap;
+
+Minimap* CreateMinimap(void);
+void DestroyMinimap(Minimap* minimap);
+void ResetMinimap(Minimap* minimap);
+void UpdateMinimap(Minimap* minimap, const int grid[GRID_HEIGHT][GRID_WIDTH], const GridBits* explored,
+                   const TileRect* area);
+void DrawMinimap(Minimap* minimap, RenderBackend* render, int playerX, int playerY);
+void ReleaseMinimapTexture(Minimap* minimap, RenderBackend* render);
+
+#endif // MINIMAP_H
\ No newline at end of file
@@ -0,0 +1,51 @@
+﻿#ifndef MONSTERAI_H
+#define MONSTERAI_H
+
+#include "DungeonDefs.h"
+#include "GridBits.h"
+#include "DistanceMap.h"
+#include "EntityStore.h"
+
+// Monsters notice the player from this many turns away (walking distance, not line of sight)
+#define MONSTER_AWARENESS_RANGE 15
+// At or below this much health a monster runs instead of fighting
+#define MONSTER_FLEE_HEALTH 2
+
+/* The flee map only covers cells up to this many turns from the player (plus the spread past them).
+ * Fleeing monsters are always within MONSTER_AWARENESS_RANGE, and once they are out of range they calm down,
+ * so anything farther out would never be read. This keeps the flee map the same size however big the floor is!
+ */
+#define FLEE_HORIZON (MONSTER_AWARENESS_RANGE * 2)
+
+/* How hard fleeing monsters prefer distance over the shortest way out.
+ * The flee map starts as the player map times -FLEE_SCALE_NUM / FLEE_SCALE_DEN and is then settled,
+ * anything above 1 makes monsters run past the player towards open space instead of into the nearest dead end!
+ */
+#define FLEE_SCALE_NUM 6
+#define FLEE_SCALE_DEN 5
+
+/* Monsters never search for paths on their own!
+ * Every monster reads the same two maps: the player distance map (downhill = towards the player),
+ * and a flee map built from it once per player turn, and only when someone is fleeing.
+ * A monster's move is then just picking its lowest free neighbour on one of them.
+ */
+typedef struct MonsterAi {
+    DistanceMap flee;
+    int order[GRID_SIZE];       // Flee map sources, sorted (and remembered so the next build can reset them)
+    int orderCount;
+    int loweredCount;           // flee.queue[0 .. loweredCount - 1] are the other cells the last build touched
+    int counts[FLEE_HORIZON + 1];
+    int huntingCount;
+    int fleeingCount;
+    bool fleeMapBuilt;
+} MonsterAi;
+
+MonsterAi* CreateMonsterAi(void);
+void DestroyMonsterAi(MonsterAi* ai);
+
+void UpdateMonsterStates(MonsterAi* ai, EntityStore* store, const DistanceMap* toward);
+void BuildFleeMap(MonsterAi* ai, const DistanceMap* toward, const FloorMasks* masks);
+void StepMonster(const MonsterAi* ai, EntityStore* store, int monster, const DistanceMap* toward,
+                 const FloorMasks* masks, int playerX, int playerY);
+
+#endif // MONSTERAI_H
\ No newline at end of file
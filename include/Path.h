@@ -3,10 +3,12 @@
 
 #include "DungeonDefs.h"
 #include "Room.h"
+#include "GenerationStats.h"
+#include "Regions.h"
 #include "Corridor.h" // Not coloured correctly on my IDE for some reason but very important, include!
 
 // Path generation constants
-#define CELL_SCOUT_AMOUNT 2    // Cell to look ahead while pathfinding
+#define CELL_SCOUT_AMOUNT 2    // Cells to look ahead for another network while pathfinding
 
 /* Higher values = more paths!
  *  For PATH_LENGTH_THRESHOLD = 1.5:
@@ -19,6 +21,7 @@
 
 // Main path generation function
 void GeneratePaths(int grid[GRID_HEIGHT][GRID_WIDTH],
-                   Room rooms[], int roomCount, int startRoomIndex, int bossRoomIndex);
+                   Room rooms[], int roomCount, int startRoomIndex, int bossRoomIndex,
+                   CorridorRegions* regions, GenerationStats* stats);
 
 #endif //PATH_H
\ No newline at end of file
@@ -1,8 +1,12 @@
 ﻿#ifndef PLAYER_H
 #define PLAYER_H
 
-#include <Raylib.h>
+#include <raylib.h>
 #include "DungeonDefs.h"
+#include "GridBits.h"
+#include "EntityStore.h"
+#include "GameInput.h"
+#include "TurnScheduler.h"
 #include <stdbool.h>
 
 typedef enum {
@@ -18,18 +22,22 @@ typedef struct
     int width;
     int height;
     Color color;
+
+    int speed;
+    int32_t energy;  // Banked energy, see SpendActionEnergy
 } Player;
 
 Player InitPlayer(int x, int y, int width, int height, Color color);
 void UpdatePlayerPosition(Player* player, int x, int y);
 
-bool IsValidPlayerPosition(int gridData[GRID_HEIGHT][GRID_WIDTH], int x, int y);
-bool HandleMovementInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
-                        int* targetX, int* targetY);
+bool IsValidPlayerPosition(const FloorMasks* masks, const EntityStore* entities, int x, int y);
+bool HandleMovementInput(Player* player, const FloorMasks* masks, const EntityStore* entities,
+                         const GameInput* input, int* targetX, int* targetY);
 
-ActionType HandleAction(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH]);
+ActionType HandleAction(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH], const GameInput* input);
 
-bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH],
+bool HandlePlayerInput(Player* player, int gridData[GRID_HEIGHT][GRID_WIDTH], const FloorMasks* masks,
+                      const EntityStore* entities, const GameInput* input,
                       ActionType* actionType, int* targetX, int* targetY);
 
 #endif //PLAYER_H
\ No newline at end of file
@@ -0,0 +1,13 @@
+﻿#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/* The dungeon's random numbers, the same generator raylib uses (rprand: splitmix64 seeding, xoshiro128**).
+ * A seed gives exactly the floors it gives through raylib's SetRandomSeed/GetRandomValue,
+ * the golden floors included, but generation, the tools and headless runs don't need raylib (or a window) for it!
+ */
+void SeedRandom(unsigned int seed);
+int GetRandomInt(int min, int max); // min and max are both included, like GetRandomValue
+
+#endif // RANDOM_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+﻿#ifndef REGIONS_H
+#define REGIONS_H
+
+#include <stdbool.h>
+#include "DungeonDefs.h"
+#include "Room.h"
+
+/* Disjoint-set labelling of the corridor networks!
+ *
+ * Every corridor, path and door cell belongs to exactly one region, two cells share a region
+ * when you can walk between them without entering a room. The labels are built once after
+ * GenerateMazes, and kept up to date as doors and path cells are placed, so asking
+ * "do these two cells belong to different networks?" is just two finds.
+ */
+#define REGION_NONE -1
+
+#define IS_REGION_CELL(cell) CELL_HAS_FLAG(cell, CELL_FLAG_REGION)
+
+typedef struct CorridorRegions {
+    int parent[GRID_SIZE];  // REGION_NONE for cells outside every network
+    unsigned char rank[GRID_SIZE];
+    int regionCount;
+} CorridorRegions;
+
+void LabelCorridorRegions(CorridorRegions* regions, int grid[GRID_HEIGHT][GRID_WIDTH]);
+void AddRegionCell(CorridorRegions* regions, int x, int y);
+void AddRoomRegions(CorridorRegions* regions, Room rooms[], int roomCount);
+int FindRegion(CorridorRegions* regions, int x, int y);
+bool UnionRegions(CorridorRegions* regions, int indexA, int indexB);
+
+#endif // REGIONS_H
\ No newline at end of file
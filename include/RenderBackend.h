@@ -0,0 +1,41 @@
+﻿#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include <raylib.h>
+
+/* Everything the game draws goes through one of these!
+ *
+ * The raylib backend just forwards to raylib, the recording backend (RenderRecorder.h) stores the commands
+ * in a buffer instead, so frame building can be measured without a window or a GL context.
+ * A frame is beginFrame, any number of draw calls, then endFrame. width and height are the size of the
+ * frame being drawn, beginFrame updates them. Draws between beginCamera and endCamera are in world space.
+ *
+ * Textures are RGBA8 and live until destroyTexture, updateTexture replaces whole rows (pixels points at row y).
+ */
+#define RENDER_NO_TEXTURE (-1)
+#define RENDER_MAX_TEXTURES 8
+
+typedef struct RenderBackend RenderBackend;
+
+struct RenderBackend {
+    void* context;  // Backend specific state
+    int width;
+    int height;
+
+    void (*beginFrame)(RenderBackend* backend, Color clearColor);
+    void (*endFrame)(RenderBackend* backend);
+    void (*beginCamera)(RenderBackend* backend, Camera2D camera);
+    void (*endCamera)(RenderBackend* backend);
+    void (*drawRectangle)(RenderBackend* backend, int x, int y, int width, int height, Color color);
+    void (*drawCircle)(RenderBackend* backend, int centerX, int centerY, float radius, Color color);
+    void (*drawText)(RenderBackend* backend, const char* text, int x, int y, int fontSize, Color color);
+
+    int (*createTexture)(RenderBackend* backend, int width, int height);
+    void (*updateTexture)(RenderBackend* backend, int texture, int y, int rowCount, const Color* pixels);
+    void (*drawTexture)(RenderBackend* backend, int texture, int x, int y, float scale, Color tint);
+    void (*destroyTexture)(RenderBackend* backend, int texture);
+};
+
+RenderBackend CreateRaylibRenderBackend(void);
+
+#endif // RENDERBACKEND_H
\ No newline at end of file
@@ -0,0 +1,55 @@
+﻿#ifndef RENDERRECORDER_H
+#define RENDERRECORDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "RenderBackend.h"
+
+/* A render backend that draws nothing, it only remembers what it was asked to draw!
+ *
+ * Every frame starts with an empty command buffer, so after endFrame the buffer holds exactly one frame.
+ * Good for counting draw calls and timing frame building on a machine without a GPU.
+ */
+#define RENDER_TEXT_SIZE 32  // Longer text is truncated, the length is still counted
+
+typedef enum RenderCommandType {
+    RENDER_CLEAR,
+    RENDER_RECTANGLE,
+    RENDER_CIRCLE,
+    RENDER_TEXT,
+    RENDER_CAMERA,      // x/y is the target, width/height the offset, scale the zoom
+    RENDER_CAMERA_END,
+    RENDER_TEXTURE_UPDATE,  // x is the texture id, y the first row, height the row count, width the bytes uploaded
+    RENDER_TEXTURE,         // width is the texture id, scale the scale
+    RENDER_COMMAND_TYPE_COUNT
+} RenderCommandType;
+
+typedef struct RenderCommand {
+    uint8_t type;
+    Color color;
+    int x;
+    int y;
+    int width;   // Rectangle width, circle radius or text font size
+    int height;
+    float scale;
+    char text[RENDER_TEXT_SIZE];
+} RenderCommand;
+
+typedef struct RenderRecorder {
+    RenderCommand* commands;
+    int commandCount;
+    int commandCapacity;
+    int frameWidth;
+    int frameHeight;
+
+    long long frameCount;
+    int textureCount;  // Ids are never reused, nothing is stored for them anyway
+    int textureWidths[RENDER_MAX_TEXTURES];
+    long long typeCounts[RENDER_COMMAND_TYPE_COUNT];  // Over every recorded frame
+} RenderRecorder;
+
+RenderRecorder* CreateRenderRecorder(int frameWidth, int frameHeight);
+void DestroyRenderRecorder(RenderRecorder* recorder);
+RenderBackend CreateRecordingRenderBackend(RenderRecorder* recorder);
+
+#endif // RENDERRECORDER_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "GameInput.h"
+
+/* Input replays, so any session can be played again exactly, hitches and failed floors included!
+ *
+ * A replay file looks like this (every number is an unsigned LEB128 varint):
+ *   "DRRP" version gridWidth gridHeight
+ *   seedCount seed, seed, ...          -> every floor seed in the order GenerateFloor rolled them
+ *   turnCounter floor playerX playerY  -> where the session ended, the replay must end there too
+ *   inputBytes                         -> followed by the input stream
+ *
+ * The input stream is one record per non-empty GameInput: idleFrames code [travelX travelY]
+ *   idleFrames is how many empty frames came before it while the game was busy (generating or travelling),
+ *   empty frames while nothing is going on don't change anything and aren't counted at all.
+ *   code is the direction in the low 4 bits ((moveY + 1) * 3 + moveX + 1) and REPLAY_INPUT_* flags above,
+ *   so a plain move is a single byte.
+ */
+#define REPLAY_FILE_MAGIC "DRRP"
+#define REPLAY_FORMAT_VERSION 1
+
+// Input code flags, the most common ones come first so they fit in one varint byte
+#define REPLAY_INPUT_DIRECTION_MASK 0x0F
+#define REPLAY_INPUT_NO_DIRECTION 4
+#define REPLAY_INPUT_ANY_KEY (1u << 4)
+#define REPLAY_INPUT_USE_STAIRS (1u << 5)
+#define REPLAY_INPUT_EXPLORE (1u << 6)
+#define REPLAY_INPUT_TRAVEL (1u << 7)
+#define REPLAY_INPUT_REGENERATE (1u << 8)
+#define REPLAY_INPUT_TOGGLE_TRACE (1u << 9)
+
+typedef enum ReplayMode {
+    REPLAY_RECORDING,
+    REPLAY_PLAYING,
+} ReplayMode;
+
+typedef struct ReplayCheckpoint {
+    uint32_t turnCounter;
+    uint32_t currentFloor;
+    uint32_t playerX;
+    uint32_t playerY;
+} ReplayCheckpoint;
+
+typedef struct Replay {
+    ReplayMode mode;
+
+    uint8_t* inputs;
+    size_t inputSize;
+    size_t inputCapacity;
+    size_t inputCursor;     // Playing only
+
+    uint32_t* seeds;
+    int seedCount;
+    int seedCapacity;
+    int seedCursor;         // Playing only
+
+    // Recording: busy frames since the last record. Playing: empty frames left before pendingInput
+    uint32_t idleFrames;
+    GameInput pendingInput;
+    bool hasPendingInput;
+
+    bool truncated;         // Recording ran out of memory, everything after that is lost
+    ReplayCheckpoint end;   // Playing only, where the recorded session ended
+} Replay;
+
+Replay* CreateReplayRecorder(void);
+Replay* LoadReplay(const char* path);
+void DestroyReplay(Replay* replay);
+bool SaveReplay(Replay* replay, const char* path, ReplayCheckpoint end);
+
+void RecordReplayInput(Replay* replay, const GameInput* input, bool busy);
+void RecordReplaySeed(Replay* replay, uint32_t seed);
+
+bool ReadReplayInput(Replay* replay, GameInput* input);
+bool ReadReplaySeed(Replay* replay, uint32_t* seed);
+
+#endif // REPLAY_H
\ No newline at end of file
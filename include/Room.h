@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "DungeonDefs.h"
+#include "GenerationStats.h"
 
 // Room Size Constants
 #define ROOM_MAX_SIZE 12
@@ -36,7 +37,7 @@ typedef struct Room {
 Room CreateRoom(int x, int y, int width, int height);
 bool IsRoomValid(int grid[GRID_HEIGHT][GRID_WIDTH], Room room);
 void PlaceRoom(int grid[GRID_HEIGHT][GRID_WIDTH], Room room, int roomId);
-bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount);
+bool GenerateRooms(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount, GenerationStats* stats);
 
 // Room finding functions
 Room FindStartingRoom(Room rooms[], int roomCount);
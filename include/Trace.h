@@ -0,0 +1,39 @@
+﻿#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Scoped trace markers, dumped as Chrome trace JSON (chrome://tracing or ui.perfetto.dev)
+ *
+ *     TRACE_BEGIN(zone, "GenerateRooms");
+ *     ...
+ *     TRACE_END(zone);
+ *
+ * Without ENABLE_TRACING the markers compile to nothing.
+ * With it, a marker costs a single branch until StartTracing is called!
+ */
+#define TRACE_EVENT_CAPACITY 65536 // Preallocated, recording stops when it's full
+
+typedef struct TraceZone {
+    const char* name; // Must be a string literal, we only store the pointer
+    uint64_t start;
+} TraceZone;
+
+#if defined(ENABLE_TRACING)
+    #define TRACE_BEGIN(zone, name) TraceZone zone = BeginTraceZone(name)
+    #define TRACE_END(zone) EndTraceZone(zone)
+#else
+    #define TRACE_BEGIN(zone, name) ((void)0)
+    #define TRACE_END(zone) ((void)0)
+#endif
+
+void StartTracing(void);
+void StopTracing(void);
+bool IsTracing(void);
+bool DumpTrace(const char* path);
+
+TraceZone BeginTraceZone(const char* name);
+void EndTraceZone(TraceZone zone);
+
+#endif // TRACE_H
\ No newline at end of file
@@ -0,0 +1,35 @@
+﻿#ifndef TRAVEL_H
+#define TRAVEL_H
+
+#include <stdbool.h>
+#include "DungeonDefs.h"
+#include "GridBits.h"
+#include "DistanceMap.h"
+
+// How many steps one UpdateGame takes while travelling, every step is still a full turn
+#define TRAVEL_STEPS_PER_UPDATE 8
+
+typedef enum {
+    TRAVEL_NONE,
+    TRAVEL_TO_CELL,  // Clicked a cell, walk there
+    TRAVEL_EXPLORE,  // Walk to the nearest cell we haven't explored yet, then the next one...
+} TravelMode;
+
+/* Travel doesn't search for a path every step!
+ * We build one flow field (a DistanceMap with distance 0 at the goal) when travel starts,
+ * and every step just walks downhill on it. Exploring only builds a new field once the goal it was heading for got explored.
+ */
+typedef struct TravelState {
+    TravelMode mode;
+    int goalX;
+    int goalY;
+    DistanceMap field;
+} TravelState;
+
+bool StartTravel(TravelState* travel, const FloorMasks* masks, int fromX, int fromY, int targetX, int targetY);
+bool StartExplore(TravelState* travel, const FloorMasks* masks, const GridBits* explored, int fromX, int fromY);
+void StopTravel(TravelState* travel);
+bool NextTravelStep(TravelState* travel, const FloorMasks* masks, const GridBits* explored, int x, int y,
+                    int* stepX, int* stepY);
+
+#endif // TRAVEL_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+﻿#ifndef TURNSCHEDULER_H
+#define TURNSCHEDULER_H
+
+#include <stdint.h>
+#include "EntityStore.h"
+
+/* Energy based turns!
+ * Every tick an actor gains its speed in energy, and it gets to act once it has ACTION_ENERGY.
+ * A speed 20 monster acts twice for every turn of a speed 10 player, a speed 5 one every other turn.
+ */
+#define ACTION_ENERGY 100
+#define SPEED_MIN 1
+#define SPEED_NORMAL 10
+#define SPEED_MAX ACTION_ENERGY
+
+// Power of two and longer than the slowest actor's wait (ACTION_ENERGY / SPEED_MIN ticks)
+#define SCHEDULE_BUCKETS 128
+
+// Entities are actors 0 .. MAX_ENTITIES - 1, the player gets the slot after them
+#define ACTOR_NONE -1
+#define ACTOR_PLAYER MAX_ENTITIES
+#define ACTOR_COUNT (MAX_ENTITIES + 1)
+
+_Static_assert((SCHEDULE_BUCKETS & (SCHEDULE_BUCKETS - 1)) == 0, "SCHEDULE_BUCKETS must be a power of two!");
+_Static_assert(SCHEDULE_BUCKETS > ACTION_ENERGY / SPEED_MIN, "The slowest actor would wrap around the schedule!");
+
+/* Rather than adding energy to every actor every tick, we work out when each one will act next
+ * and drop it in that tick's bucket. The buckets form a ring, one per tick, and since nobody waits longer
+ * than SCHEDULE_BUCKETS ticks, a bucket only ever holds actors for a single tick.
+ * Inserting is an append to a bucket, and finding the next actor only skips empty buckets,
+ * no matter how many actors there are!
+ *
+ * Buckets are doubly linked lists threaded through next/prev, so an actor can leave early (e.g. when it dies).
+ * Actors in the same bucket act in the order they were scheduled.
+ */
+typedef struct TurnScheduler {
+    long long now;  // Current tick, only ever goes up
+    int scheduledCount;
+
+    int head[SCHEDULE_BUCKETS];
+    int tail[SCHEDULE_BUCKETS];
+
+    int next[ACTOR_COUNT];
+    int prev[ACTOR_COUNT];
+    int16_t bucketOf[ACTOR_COUNT];  // -1 when the actor isn't scheduled
+} TurnScheduler;
+
+TurnScheduler* CreateTurnScheduler(void);
+void DestroyTurnScheduler(TurnScheduler* scheduler);
+void ClearScheduler(TurnScheduler* scheduler);
+
+void ScheduleActor(TurnScheduler* scheduler, int actor, int delay);
+void UnscheduleActor(TurnScheduler* scheduler, int actor);
+int PeekNextActor(TurnScheduler* scheduler);
+int PopNextActor(TurnScheduler* scheduler);
+
+int SpendActionEnergy(int32_t* energy, int speed);
+
+#endif // TURNSCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+﻿#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include "DungeonDefs.h"
+
+/* The camera that follows the player around, and which part of the grid it can see!
+ *
+ * World space is grid space in pixels (cell x starts at x * CELL_SIZE), the camera maps it onto the frame
+ * with the player in the middle. Drawing only walks the TileRect the camera can see, so a frame costs
+ * the same on a 69x69 floor as on a huge one.
+ */
+#define CAMERA_ZOOM_DEFAULT 1.0f
+#define CAMERA_ZOOM_MIN 0.25f
+#define CAMERA_ZOOM_MAX 4.0f
+#define CAMERA_ZOOM_STEP 1.25f  // Per wheel notch or key press
+
+// Inclusive, and empty when minX > maxX or minY > maxY
+typedef struct TileRect {
+    int minX;
+    int minY;
+    int maxX;
+    int maxY;
+} TileRect;
+
+Camera2D GetFollowCamera(int cellX, int cellY, float zoom, int frameWidth, int frameHeight);
+TileRect GetVisibleTiles(const Camera2D* camera, int frameWidth, int frameHeight);
+bool ScreenToGridCell(const Camera2D* camera, Vector2 screen, int* cellX, int* cellY);
+float ApplyZoomSteps(float zoom, int steps);
+
+#endif // VIEWPORT_H
\ No newline at end of file
@@ -1,23 +1,105 @@
-﻿#include <stdio.h>
+﻿#include <stdlib.h>
+#include <time.h>
 #include <raylib.h>
 #include "Game.h"
+#include "Log.h"
+#include "Random.h"
 
-int main(void)
+// Every session is recorded, play it back with ReplayRunner
+#define REPLAY_PATH "last.replay"
+
+int main(int argc, char* argv[])
 {
     const int width = 1920;
     const int height = 1080;
 
+    // Console output goes through a background thread from here on
+    StartLogger();
+
     InitWindow(width, height, "Dungeon Rogue C!");
-    SetTargetFPS(400);
+    SeedRandom((unsigned int)time(NULL)); // InitWindow only seeds raylib's generator, the dungeon has its own
+    SetTargetFPS(400); // Only matters while travelling or generating, idle frames wait for input instead
 
     Game game = InitGame(width, height);
 
+    // Challenge mode: DungeonRogue_C <floor pack> <seed>
+    FloorPack floorPack;
+
+    if (argc >= 3 && OpenFloorPack(argv[1], &floorPack))
+    {
+        game.floorPack = &floorPack;
+        game.challengeSeed = (unsigned int)strtoul(argv[2], NULL, 10);
+
+        GAME_LOG_INFO("Challenge mode: %u floors in %s, seed %u",
+                      floorPack.header->floorCount, argv[1], game.challengeSeed);
+    }
+
+    // A few bytes per turn, nothing to worry about even for very long sessions
+    game.replay = CreateReplayRecorder();
+
+    RenderBackend render = CreateRaylibRenderBackend();
+
+    /* The game is turn based, nothing moves until a key is pressed!
+     * So when there's no travel or floor generation going on, the loop sleeps until the OS hands us an input event,
+     * and a frame is only drawn when UpdateGame says something changed. Idle CPU use drops to about nothing.
+     */
+    bool redraw = true;
+    bool waitingForEvents = false;
+
     while (!WindowShouldClose())
     {
-        UpdateGame(&game);
-        DrawGame(game);
+        const Camera2D camera = GetGameCamera(&game, GetScreenWidth(), GetScreenHeight());
+
+        if (UpdateGame(&game, ReadKeyboardInput(&camera)) || IsWindowResized())
+        {
+            redraw = true;
+        }
+
+        // Travel and generation keep going without input, those frames must not block
+        const bool idle = !IsGameBusy(&game);
+
+        if (idle != waitingForEvents)
+        {
+            if (idle)
+            {
+                EnableEventWaiting();
+            }
+            else
+            {
+                DisableEventWaiting();
+            }
+
+            waitingForEvents = idle;
+        }
+
+        if (redraw)
+        {
+            DrawGame(&game, &render); // EndDrawing polls (or waits for) the next events
+            redraw = false;
+        }
+        else
+        {
+            PollInputEvents(); // Nothing to draw, just block until something happens
+        }
+    }
+
+    if (game.replay != NULL)
+    {
+        SaveReplay(game.replay, REPLAY_PATH, GetGameCheckpoint(&game));
+        DestroyReplay(game.replay);
     }
 
+    if (game.floorPack != NULL)
+    {
+        CloseFloorPack(&floorPack);
+    }
+
+    // GPU resources go before the window does
+    ReleaseMinimapTexture(game.minimap, &render);
+
+    UnloadGame(&game);
     CloseWindow();
+    StopLogger();
+
     return 0;
 }
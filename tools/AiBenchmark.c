@@ -0,0 +1,206 @@
+﻿#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Clock.h"
+#include "DistanceMap.h"
+#include "EntityStore.h"
+#include "GridBits.h"
+#include "Log.h"
+#include "MonsterAi.h"
+
+/* Per-turn monster AI cost at 1k, 10k and 100k monsters!
+ *
+ * Usage: AiBenchmark [turns]
+ *
+ * Built with a much bigger grid and entity store than the game (see CMakeLists.txt), since 100k monsters
+ * don't fit on a 69x69 floor. The floor is one big open arena with random pillars, the player walks around
+ * in the middle, and every turn does exactly what EndPlayerTurn does: update the player map, one state pass,
+ * the flee map when needed, then every monster takes one step.
+ */
+#define BENCH_DEFAULT_TURNS 50
+#define BENCH_PILLAR_PERCENT 15
+#define BENCH_WEAK_PERCENT 10 // Monsters spawned at flee health, so the flee map gets built every turn
+
+static const int BENCH_ACTOR_COUNTS[] = { 1000, 10000, 100000 };
+#define BENCH_RUN_COUNT ((int)(sizeof(BENCH_ACTOR_COUNTS) / sizeof(BENCH_ACTOR_COUNTS[0])))
+
+// Our own little xorshift, the benchmark doesn't need raylib
+static uint32_t benchState = 2463534242u;
+
+static int BenchRandom(int min, int max)
+{
+    benchState ^= benchState << 13;
+    benchState ^= benchState >> 17;
+    benchState ^= benchState << 5;
+
+    return min + (int)(benchState % (uint32_t)(max - min + 1));
+}
+
+static void BuildArena(int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            const bool border = !IS_VALID_CELL(x, y);
+            const bool pillar = BenchRandom(0, 99) < BENCH_PILLAR_PERCENT;
+
+            grid[y][x] = (border || pillar) ? CELL_EMPTY_1 : ROOM_ID_START;
+        }
+    }
+
+    grid[HALF(GRID_HEIGHT)][HALF(GRID_WIDTH)] = ROOM_ID_START; // The player starts here
+}
+
+typedef struct BenchTimes {
+    uint64_t playerMap;
+    uint64_t states;
+    uint64_t fleeMap;
+    uint64_t moves;
+} BenchTimes;
+
+static double ToMilliseconds(uint64_t nanoseconds, int turns)
+{
+    return (double)nanoseconds / 1e6 / turns;
+}
+
+static void RunBenchmark(int actorCount, int turns, const FloorMasks* masks, EntityStore* store, MonsterAi* ai,
+                         DistanceMap* toward)
+{
+    ClearEntities(store);
+
+    for (int spawned = 0; spawned < actorCount;)
+    {
+        const int x = BenchRandom(1, GRID_WIDTH - 2);
+        const int y = BenchRandom(1, GRID_HEIGHT - 2);
+
+        if (!IsWalkable(masks, x, y) || (x == HALF(GRID_WIDTH) && y == HALF(GRID_HEIGHT)))
+        {
+            continue;
+        }
+
+        const int health = (BenchRandom(0, 99) < BENCH_WEAK_PERCENT) ? MONSTER_FLEE_HEALTH : 10;
+
+        if (SpawnEntity(store, ENTITY_MONSTER, x, y, health) != ENTITY_NONE)
+        {
+            spawned++;
+        }
+    }
+
+    int playerX = HALF(GRID_WIDTH);
+    int playerY = HALF(GRID_HEIGHT);
+    BuildDistanceMap(toward, masks, playerX, playerY);
+
+    BenchTimes times = { 0 };
+    long long hunting = 0;
+    long long fleeing = 0;
+
+    for (int turn = 0; turn < turns; turn++)
+    {
+        // The player takes a random step, just like a real turn (blocked steps just stand still)
+        const int stepX = playerX + BenchRandom(-1, 1);
+        const int stepY = playerY + BenchRandom(-1, 1);
+
+        if (IsWalkable(masks, stepX, stepY) && GetOccupant(store, stepX, stepY) == ENTITY_NONE)
+        {
+            playerX = stepX;
+            playerY = stepY;
+        }
+
+        uint64_t start = GetClockNanoseconds();
+        MoveDistanceMapSource(toward, masks, playerX, playerY);
+        uint64_t end = GetClockNanoseconds();
+        times.playerMap += end - start;
+
+        start = end;
+        UpdateMonsterStates(ai, store, toward);
+        end = GetClockNanoseconds();
+        times.states += end - start;
+
+        start = end;
+        if (ai->fleeingCount > 0)
+        {
+            BuildFleeMap(ai, toward, masks);
+        }
+        end = GetClockNanoseconds();
+        times.fleeMap += end - start;
+
+        start = end;
+        for (int i = 0; i < store->highWater; i++)
+        {
+            if (store->alive[i])
+            {
+                StepMonster(ai, store, i, toward, masks, playerX, playerY);
+            }
+        }
+        end = GetClockNanoseconds();
+        times.moves += end - start;
+
+        hunting += ai->huntingCount;
+        fleeing += ai->fleeingCount;
+    }
+
+    // The player map is shared with everything else in the game, so it's reported on its own
+    const uint64_t aiTime = times.states + times.fleeMap + times.moves;
+
+    printf("%7d monsters | states %7.3f ms | flee map %7.3f ms | moves %7.3f ms | AI %7.3f ms/turn"
+           " | player map %7.3f ms | hunting %lld fleeing %lld\n",
+           actorCount,
+           ToMilliseconds(times.states, turns), ToMilliseconds(times.fleeMap, turns),
+           ToMilliseconds(times.moves, turns), ToMilliseconds(aiTime, turns),
+           ToMilliseconds(times.playerMap, turns), hunting / turns, fleeing / turns);
+}
+
+int main(int argc, char* argv[])
+{
+    const int turns = (argc >= 2) ? atoi(argv[1]) : BENCH_DEFAULT_TURNS;
+
+    if (turns <= 0)
+    {
+        printf("Usage: %s [turns]\n", argv[0]);
+        return 1;
+    }
+
+    // Everything here is sized by the benchmark grid, far too big for the stack
+    int (*grid)[GRID_WIDTH] = malloc(sizeof(int) * GRID_SIZE);
+    FloorMasks* masks = malloc(sizeof(FloorMasks));
+    DistanceMap* toward = malloc(sizeof(DistanceMap));
+
+    StartLogger();
+
+    EntityStore* store = CreateEntityStore();
+    MonsterAi* ai = CreateMonsterAi();
+
+    if (grid == NULL || masks == NULL || toward == NULL || store == NULL || ai == NULL)
+    {
+        printf("Benchmark allocation failed!\n");
+        return 1;
+    }
+
+    BuildArena(grid);
+    BuildFloorMasks(masks, grid);
+
+    printf("Arena %dx%d, %d turns, monsters notice the player from %d turns away\n",
+           GRID_WIDTH, GRID_HEIGHT, turns, MONSTER_AWARENESS_RANGE);
+
+    for (int i = 0; i < BENCH_RUN_COUNT; i++)
+    {
+        if (BENCH_ACTOR_COUNTS[i] > MAX_ENTITIES)
+        {
+            printf("%7d monsters | skipped, MAX_ENTITIES is %d\n", BENCH_ACTOR_COUNTS[i], MAX_ENTITIES);
+            continue;
+        }
+
+        RunBenchmark(BENCH_ACTOR_COUNTS[i], turns, masks, store, ai, toward);
+    }
+
+    DestroyMonsterAi(ai);
+    DestroyEntityStore(store);
+    free(toward);
+    free(masks);
+    free(grid);
+
+    StopLogger();
+
+    return 0;
+}
\ No newline at end of file
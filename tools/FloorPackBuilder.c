@@ -0,0 +1,210 @@
+﻿#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "Dungeon.h"
+#include "FloorPack.h"
+#include "FloorValidator.h"
+#include "Log.h"
+
+/* Offline batch generator for floor packs!
+ *
+ * Usage: FloorPackBuilder <output.pack> <first challenge seed> <runs> <floors per run>
+ *
+ * Builds the challenge runs firstSeed .. firstSeed + runs - 1 into one pack (a year of daily challenges is 365 runs).
+ * Floor N (1 .. floors per run) of run s is generated from CHALLENGE_FLOOR_SEED(s, N) with GenerateSeededDungeon,
+ * exactly like the game does, so a packed floor always matches its live counterpart.
+ * Play a run with: DungeonRogue_C <output.pack> <challenge seed>
+ *
+ * Seeds that fail to generate (or to validate) are simply left out of the pack, the game falls back
+ * to generating them itself (and failing the same way).
+ */
+#define MAX_GENERATION_ATTEMPTS 5
+
+/* Opens the finished pack and looks every floor of every run up the way the game's LoadFloorFromPack does,
+ * so a pack that only serves some of its floors never ships!
+ * generated holds one flag per floor, run by run. Returns the number of floors that don't round-trip.
+ */
+static int VerifyChallengePack(const char* path, unsigned int firstSeed, int runs, int floorsPerRun,
+                               const bool* generated, int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    FloorPack pack;
+
+    if (!OpenFloorPack(path, &pack))
+    {
+        return runs * floorsPerRun;
+    }
+
+    Room rooms[ROOM_AMOUNT];
+    int roomCount = 0;
+    int misses = 0;
+
+    for (int run = 0; run < runs; run++)
+    {
+        const unsigned int challengeSeed = firstSeed + (unsigned int)run;
+
+        for (int floor = 1; floor <= floorsPerRun; floor++)
+        {
+            const unsigned int seed = CHALLENGE_FLOOR_SEED(challengeSeed, floor);
+            FloorView view;
+
+            const bool loaded = FindPackedFloor(&pack, seed, floor, &view) &&
+                                DecodeFloorView(view, grid, rooms, &roomCount) &&
+                                ValidateFloorConnectivity(grid, rooms, roomCount) == FLOOR_REACHABLE;
+
+            if (loaded != generated[run * floorsPerRun + floor - 1])
+            {
+                printf("Challenge %u floor %d (seed %u) %s!\n", challengeSeed, floor, seed,
+                       loaded ? "is in the pack but failed to generate" : "does not load from the pack");
+                misses++;
+            }
+        }
+    }
+
+    CloseFloorPack(&pack);
+
+    return misses;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        printf("Usage: %s <output.pack> <first challenge seed> <runs> <floors per run>\n", argv[0]);
+        return 1;
+    }
+
+    const char* outputPath = argv[1];
+    const unsigned int firstSeed = (unsigned int)strtoul(argv[2], NULL, 10);
+    const int runs = atoi(argv[3]);
+    const int floorsPerRun = atoi(argv[4]);
+
+    // Floor numbers are 16-bit in the pack, the total only has to fit the writer
+    if (runs <= 0 || floorsPerRun <= 0 || floorsPerRun > UINT16_MAX ||
+        (long long)runs * floorsPerRun > INT_MAX)
+    {
+        printf("Runs must be positive and floors per run between 1 and %d (at most %d floors in total)!\n",
+               UINT16_MAX, INT_MAX);
+        return 1;
+    }
+
+    const int count = runs * floorsPerRun;
+
+    StartLogger();
+
+    // The grid is too big to comfortably live on the stack
+    int (*grid)[GRID_WIDTH] = malloc(sizeof(int) * GRID_SIZE);
+    bool* generatedFloors = calloc((size_t)count, sizeof(bool));
+    if (grid == NULL || generatedFloors == NULL)
+    {
+        printf("Allocation failed!\n");
+        free(grid);
+        free(generatedFloors);
+        return 1;
+    }
+
+    FloorPackWriter writer;
+    if (!BeginFloorPack(&writer, outputPath, count))
+    {
+        free(grid);
+        free(generatedFloors);
+        return 1;
+    }
+
+    Room rooms[ROOM_AMOUNT];
+    int roomCount = 0;
+    int attemptsUsed = 0;
+    int failedSeeds = 0;
+    GenerationStats stats;
+    GenerationStats totals = { 0 };
+    const clock_t startTime = clock();
+
+    for (int i = 0; i < count; i++)
+    {
+        const unsigned int challengeSeed = firstSeed + (unsigned int)(i / floorsPerRun);
+        const int floorNumber = i % floorsPerRun + 1;
+        const unsigned int seed = CHALLENGE_FLOOR_SEED(challengeSeed, floorNumber);
+
+        const bool generated = GenerateSeededDungeon(grid, seed, MAX_GENERATION_ATTEMPTS, floorNumber,
+                                                     rooms, &roomCount, &attemptsUsed, &stats);
+
+        // Failed seeds did work too, count everything
+        totals.roomPlacementAttempts += stats.roomPlacementAttempts;
+        totals.roomPlacementRejections += stats.roomPlacementRejections;
+        totals.mazeFloodFillSeeds += stats.mazeFloodFillSeeds;
+        totals.corridorCellsCarved += stats.corridorCellsCarved;
+        totals.doorCorridorProbes += stats.doorCorridorProbes;
+        totals.doorFallbackPlacements += stats.doorFallbackPlacements;
+        totals.pathSearches += stats.pathSearches;
+        totals.pathNodesExpanded += stats.pathNodesExpanded;
+        totals.pathFallbackEscalations += stats.pathFallbackEscalations;
+        totals.pathCellsPlaced += stats.pathCellsPlaced;
+        totals.connectorCandidates += stats.connectorCandidates;
+        totals.connectorsCarved += stats.connectorsCarved;
+        totals.connectorCellsPlaced += stats.connectorCellsPlaced;
+        totals.floorsFailedValidation += stats.floorsFailedValidation;
+
+        if (!generated)
+        {
+            failedSeeds++;
+            continue;
+        }
+
+        if (!AddFloorToPack(&writer, grid, rooms, roomCount, seed, floorNumber))
+        {
+            printf("Failed to write seed %u!\n", seed);
+            EndFloorPack(&writer);
+            free(grid);
+            free(generatedFloors);
+            return 1;
+        }
+
+        generatedFloors[i] = true;
+    }
+
+    const int packedFloors = (int)writer.floorCount;
+    const double seconds = (double)(clock() - startTime) / CLOCKS_PER_SEC;
+
+    if (!EndFloorPack(&writer))
+    {
+        printf("Failed to finish %s!\n", outputPath);
+        free(grid);
+        free(generatedFloors);
+        return 1;
+    }
+
+    const int misses = VerifyChallengePack(outputPath, firstSeed, runs, floorsPerRun, generatedFloors, grid);
+
+    printf("Packed %d floors into %s (%d seeds failed) in %.2fs, %.0f floors/s\n",
+           packedFloors, outputPath, failedSeeds, seconds, seconds > 0.0 ? count / seconds : 0.0);
+
+    // Average work per seed, handy for comparing generator changes
+    printf("Per seed: rooms %.1f attempts / %.1f rejected, mazes %.1f seeds / %.1f cells, doors %.1f probes / %.2f fallbacks\n",
+           (double)totals.roomPlacementAttempts / count, (double)totals.roomPlacementRejections / count,
+           (double)totals.mazeFloodFillSeeds / count, (double)totals.corridorCellsCarved / count,
+           (double)totals.doorCorridorProbes / count, (double)totals.doorFallbackPlacements / count);
+    printf("Per seed: paths %.1f searches / %.1f nodes expanded / %.2f escalations / %.1f cells placed\n",
+           (double)totals.pathSearches / count, (double)totals.pathNodesExpanded / count,
+           (double)totals.pathFallbackEscalations / count, (double)totals.pathCellsPlaced / count);
+    printf("Per seed: connectors %.1f candidates / %.1f carved / %.1f cells placed\n",
+           (double)totals.connectorCandidates / count, (double)totals.connectorsCarved / count,
+           (double)totals.connectorCellsPlaced / count);
+    printf("Attempts rejected by the validator: %lld\n", totals.floorsFailedValidation);
+
+    if (misses == 0)
+    {
+        printf("Challenges %u..%u: %d of %d floors load from the pack, the other %d fail live as well\n",
+               firstSeed, firstSeed + (unsigned int)(runs - 1), packedFloors, count, failedSeeds);
+    }
+    else
+    {
+        printf("Challenges %u..%u: %d floors don't round-trip through the pack!\n",
+               firstSeed, firstSeed + (unsigned int)(runs - 1), misses);
+    }
+
+    free(grid);
+    free(generatedFloors);
+    StopLogger();
+
+    return misses == 0 ? 0 : 1;
+}
\ No newline at end of file
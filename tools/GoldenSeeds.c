@@ -0,0 +1,390 @@
+﻿#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Dungeon.h"
+#include "FloorFile.h"
+#include "Log.h"
+
+/* Golden-seed regression check for the generators!
+ *
+ * Usage: GoldenSeeds <record|check|diff> <golden.txt> <reference.drf>
+ *
+ *   record -> generates GOLDEN_SEEDS and writes their hashes and a reference floor file
+ *   check  -> regenerates every seed in the golden file and compares hashes, exits with 1 on any mismatch
+ *   diff   -> like check, but also decodes the reference floor and reports the first differing cell
+ *
+ * Anything that touches Room.c, Corridor.c, Door.c or Path.c has to pass check before it goes in.
+ * A faster kernel is only a drop-in replacement if every floor comes out bit-identical!
+ * Only re-record when a layout change is intended, and commit both files together.
+ * The goldens are recorded with the default generator, without USE_CONNECTOR_STAGE.
+ */
+#define GOLDEN_MAX_ENTRIES 256
+#define GOLDEN_MAX_GENERATION_ATTEMPTS 5 // Must match the game, attempts change the random stream
+
+typedef struct GoldenSeed {
+    unsigned int seed;
+    int floorNumber;
+} GoldenSeed;
+
+typedef struct GoldenEntry {
+    unsigned int seed;
+    int floorNumber;
+    int generated;
+    uint64_t gridHash;
+    uint64_t roomHash;
+} GoldenEntry;
+
+// Some small seeds, some large ones, and a few deeper floors since those also place an up staircase
+static const GoldenSeed GOLDEN_SEEDS[] = {
+    { 1, 1 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 1 }, { 6, 1 }, { 7, 1 }, { 8, 1 },
+    { 42, 1 }, { 1337, 1 }, { 65535, 1 }, { 65536, 1 }, { 123456789, 1 }, { 4294967295u, 1 },
+    { 11, 2 }, { 12, 2 }, { 13, 3 }, { 14, 3 }, { 2024, 4 }, { 99991, 5 },
+    { 31337, 7 }, { 777777, 9 }, { 2718281828u, 12 }, { 3141592653u, 20 },
+};
+
+#define GOLDEN_SEED_COUNT ((int)(sizeof(GOLDEN_SEEDS) / sizeof(GOLDEN_SEEDS[0])))
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// FNV-1a, fed byte by byte in little endian order so the hashes don't depend on the machine
+static uint64_t HashValue(uint64_t hash, int value)
+{
+    const uint32_t bits = (uint32_t)value;
+
+    for (int i = 0; i < 4; i++)
+    {
+        hash ^= (bits >> (i * 8)) & 0xFF;
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static uint64_t HashGrid(int grid[GRID_HEIGHT][GRID_WIDTH])
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            hash = HashValue(hash, grid[y][x]);
+        }
+    }
+
+    return hash;
+}
+
+static uint64_t HashRooms(Room rooms[], int roomCount)
+{
+    uint64_t hash = HashValue(FNV_OFFSET_BASIS, roomCount);
+
+    for (int i = 0; i < roomCount; i++)
+    {
+        hash = HashValue(hash, rooms[i].x);
+        hash = HashValue(hash, rooms[i].y);
+        hash = HashValue(hash, rooms[i].width);
+        hash = HashValue(hash, rooms[i].height);
+        hash = HashValue(hash, rooms[i].type);
+    }
+
+    return hash;
+}
+
+static void GenerateEntry(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int* roomCount, GoldenEntry* entry)
+{
+    int attemptsUsed = 0;
+    GenerationStats stats;
+
+    *roomCount = 0;
+    entry->generated = GenerateSeededDungeon(grid, entry->seed, GOLDEN_MAX_GENERATION_ATTEMPTS,
+                                             entry->floorNumber, rooms, roomCount, &attemptsUsed, &stats);
+    entry->gridHash = HashGrid(grid);
+    entry->roomHash = HashRooms(rooms, *roomCount);
+}
+
+static int LoadGoldenFile(const char* path, GoldenEntry entries[])
+{
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+    {
+        printf("Could not open golden file %s, run record first!\n", path);
+        return -1;
+    }
+
+    char line[256];
+    int count = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+        {
+            continue;
+        }
+
+        if (count == GOLDEN_MAX_ENTRIES)
+        {
+            printf("Too many entries in %s, only the first %d are checked!\n", path, GOLDEN_MAX_ENTRIES);
+            break;
+        }
+
+        GoldenEntry* entry = &entries[count];
+        unsigned long long gridHash = 0;
+        unsigned long long roomHash = 0;
+
+        if (sscanf(line, "%u %d %d %llx %llx", &entry->seed, &entry->floorNumber, &entry->generated,
+                   &gridHash, &roomHash) != 5)
+        {
+            printf("Malformed line in %s: %s", path, line);
+            fclose(file);
+            return -1;
+        }
+
+        entry->gridHash = gridHash;
+        entry->roomHash = roomHash;
+        count++;
+    }
+
+    fclose(file);
+    return count;
+}
+
+static int Record(int grid[GRID_HEIGHT][GRID_WIDTH], const char* goldenPath, const char* referencePath)
+{
+    FILE* file = fopen(goldenPath, "w");
+    if (file == NULL)
+    {
+        printf("Could not create golden file %s!\n", goldenPath);
+        return 1;
+    }
+
+    FloorFileWriter writer;
+    if (!BeginFloorFile(&writer, referencePath, GOLDEN_SEED_COUNT))
+    {
+        fclose(file);
+        return 1;
+    }
+
+    fprintf(file, "# Golden floors, written by GoldenSeeds record. Do not edit by hand!\n");
+    fprintf(file, "# seed floor generated gridHash roomHash\n");
+
+    Room rooms[ROOM_AMOUNT];
+    int roomCount = 0;
+    bool success = true;
+
+    for (int i = 0; i < GOLDEN_SEED_COUNT && success; i++)
+    {
+        GoldenEntry entry = { .seed = GOLDEN_SEEDS[i].seed, .floorNumber = GOLDEN_SEEDS[i].floorNumber };
+        GenerateEntry(grid, rooms, &roomCount, &entry);
+
+        fprintf(file, "%u %d %d %016llx %016llx\n", entry.seed, entry.floorNumber, entry.generated,
+                (unsigned long long)entry.gridHash, (unsigned long long)entry.roomHash);
+
+        // Failed floors are stored too, the half-built grid is part of the behaviour we're guarding
+        success = AppendFloor(&writer, grid, rooms, roomCount, entry.seed, entry.floorNumber);
+    }
+
+    success = EndFloorFile(&writer) && success;
+    success = (fclose(file) == 0) && success;
+
+    if (!success)
+    {
+        printf("Failed to record golden floors!\n");
+        return 1;
+    }
+
+    printf("Recorded %d golden floors into %s and %s\n", GOLDEN_SEED_COUNT, goldenPath, referencePath);
+    return 0;
+}
+
+// Finds the reference record for a seed, the floor file is small enough to just walk
+static bool FindReferenceFloor(const FloorFile* reference, const GoldenEntry* entry, FloorView* view)
+{
+    for (uint32_t i = 0; i < reference->header->floorCount; i++)
+    {
+        if (GetFloorView(reference, (int)i, view) &&
+            view->header->seed == entry->seed && view->header->floorNumber == entry->floorNumber)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void ReportFirstDifference(int grid[GRID_HEIGHT][GRID_WIDTH], Room rooms[], int roomCount,
+                                  const FloorFile* reference, const GoldenEntry* entry,
+                                  int referenceGrid[GRID_HEIGHT][GRID_WIDTH])
+{
+    FloorView view;
+    Room referenceRooms[ROOM_AMOUNT];
+    int referenceRoomCount = 0;
+
+    if (!FindReferenceFloor(reference, entry, &view) ||
+        !DecodeFloorView(view, referenceGrid, referenceRooms, &referenceRoomCount))
+    {
+        printf("    no reference floor for seed %u, re-record to get one\n", entry->seed);
+        return;
+    }
+
+    // Row-major, so this is the first cell the generators wrote differently
+    for (int y = 0; y < GRID_HEIGHT; y++)
+    {
+        for (int x = 0; x < GRID_WIDTH; x++)
+        {
+            if (grid[y][x] != referenceGrid[y][x])
+            {
+                printf("    first differing cell at (%d, %d): expected %d, got %d\n",
+                       x, y, referenceGrid[y][x], grid[y][x]);
+                y = GRID_HEIGHT;
+                break;
+            }
+        }
+    }
+
+    if (roomCount != referenceRoomCount)
+    {
+        printf("    room count differs: expected %d, got %d\n", referenceRoomCount, roomCount);
+    }
+
+    for (int i = 0; i < roomCount && i < referenceRoomCount; i++)
+    {
+        const Room expected = referenceRooms[i];
+        const Room actual = rooms[i];
+
+        if (expected.x != actual.x || expected.y != actual.y || expected.width != actual.width ||
+            expected.height != actual.height || expected.type != actual.type)
+        {
+            printf("    first differing room %d: expected %dx%d at (%d, %d) type %d, got %dx%d at (%d, %d) type %d\n",
+                   i, expected.width, expected.height, expected.x, expected.y, expected.type,
+                   actual.width, actual.height, actual.x, actual.y, actual.type);
+            break;
+        }
+    }
+}
+
+static int Check(int grid[GRID_HEIGHT][GRID_WIDTH], const char* goldenPath, const char* referencePath,
+                 bool reportDifferences)
+{
+    GoldenEntry* golden = malloc(sizeof(GoldenEntry) * GOLDEN_MAX_ENTRIES);
+    int (*referenceGrid)[GRID_WIDTH] = malloc(sizeof(int) * GRID_SIZE);
+
+    if (golden == NULL || referenceGrid == NULL)
+    {
+        printf("Golden check allocation failed!\n");
+        free(golden);
+        free(referenceGrid);
+        return 1;
+    }
+
+    const int count = LoadGoldenFile(goldenPath, golden);
+    if (count <= 0)
+    {
+        if (count == 0)
+        {
+            printf("%s holds no golden floors, run record first!\n", goldenPath);
+        }
+
+        free(golden);
+        free(referenceGrid);
+        return 1;
+    }
+
+    FloorFile reference = { 0 };
+    if (reportDifferences && !OpenFloorFile(referencePath, &reference))
+    {
+        printf("Could not open reference floors %s, only hashes will be compared\n", referencePath);
+        reportDifferences = false;
+    }
+
+    Room rooms[ROOM_AMOUNT];
+    int roomCount = 0;
+    int mismatches = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        GoldenEntry actual = { .seed = golden[i].seed, .floorNumber = golden[i].floorNumber };
+        GenerateEntry(grid, rooms, &roomCount, &actual);
+
+        if (actual.generated == golden[i].generated && actual.gridHash == golden[i].gridHash &&
+            actual.roomHash == golden[i].roomHash)
+        {
+            continue;
+        }
+
+        mismatches++;
+        printf("MISMATCH seed %u floor %d: generated %d/%d, grid %016llx/%016llx, rooms %016llx/%016llx (expected/got)\n",
+               actual.seed, actual.floorNumber, golden[i].generated, actual.generated,
+               (unsigned long long)golden[i].gridHash, (unsigned long long)actual.gridHash,
+               (unsigned long long)golden[i].roomHash, (unsigned long long)actual.roomHash);
+
+        if (reportDifferences)
+        {
+            ReportFirstDifference(grid, rooms, roomCount, &reference, &golden[i], referenceGrid);
+        }
+    }
+
+    if (reference.header != NULL)
+    {
+        CloseFloorFile(&reference);
+    }
+
+    free(golden);
+    free(referenceGrid);
+
+    if (mismatches > 0)
+    {
+        printf("%d of %d golden floors changed!\n", mismatches, count);
+        return 1;
+    }
+
+    printf("All %d golden floors match\n", count);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 4)
+    {
+        printf("Usage: %s <record|check|diff> <golden.txt> <reference.drf>\n", argv[0]);
+        return 1;
+    }
+
+    const char* mode = argv[1];
+    const char* goldenPath = argv[2];
+    const char* referencePath = argv[3];
+
+    if (strcmp(mode, "record") != 0 && strcmp(mode, "check") != 0 && strcmp(mode, "diff") != 0)
+    {
+        printf("Unknown mode %s, expected record, check or diff!\n", mode);
+        return 1;
+    }
+
+    // The grid is too big to comfortably live on the stack
+    int (*grid)[GRID_WIDTH] = malloc(sizeof(int) * GRID_SIZE);
+    if (grid == NULL)
+    {
+        printf("Grid allocation failed!\n");
+        return 1;
+    }
+
+    StartLogger();
+
+    int result;
+
+    if (strcmp(mode, "record") == 0)
+    {
+        result = Record(grid, goldenPath, referencePath);
+    }
+    else
+    {
+        result = Check(grid, goldenPath, referencePath, strcmp(mode, "diff") == 0);
+    }
+
+    free(grid);
+    StopLogger();
+
+    return result;
+}
\ No newline at end of file
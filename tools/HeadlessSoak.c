@@ -0,0 +1,210 @@
+﻿#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "Clock.h"
+#include "Game.h"
+#include "Log.h"
+#include "Random.h"
+
+/* Plays the game with no window at all, as fast as it'll go!
+ *
+ * Usage: HeadlessSoak [turns] [seed] [replay file]
+ *
+ * A random agent feeds UpdateGame the same GameInput the keyboard would: mostly it heads for the stairs
+ * down along the shared stair map, sometimes it wanders, explores, goes back up or regenerates the floor.
+ * That way every run goes through plenty of stair transitions and G-regenerations, and the totals
+ * (turns/s and floors/s) make for a cheap soak test on CI. The same seed always plays the same run,
+ * and with a replay file the run is recorded too, so ReplayRunner can play it back.
+ */
+#define SOAK_DEFAULT_TURNS 20000
+#define SOAK_DEFAULT_SEED 1
+#define SOAK_UPDATES_PER_TURN 8 // Give up once this many updates didn't get us to the wanted turn count
+
+// Agent odds, out of 1000 per update
+#define AGENT_REGENERATE_CHANCE 2
+#define AGENT_EXPLORE_CHANCE 20
+#define AGENT_WANDER_CHANCE 300
+#define AGENT_GO_UP_CHANCE 100  // When standing on the stairs up
+
+static const int agentDirX[] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int agentDirY[] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+// Our own little xorshift, so the agent doesn't disturb the generator's random sequence
+static uint32_t agentState = 2463534242u;
+
+static int AgentRandom(int min, int max)
+{
+    agentState ^= agentState << 13;
+    agentState ^= agentState >> 17;
+    agentState ^= agentState << 5;
+
+    return min + (int)(agentState % (uint32_t)(max - min + 1));
+}
+
+// The free neighbour closest to the stairs down, false when every neighbour is further away or taken
+static bool StepTowardStairs(const Game* game, int* moveX, int* moveY)
+{
+    int best = GetMapDistance(&game->stairDownDistances, game->playerPos.x, game->playerPos.y);
+    bool found = false;
+
+    for (int i = 0; i < 8; i++)
+    {
+        const int x = game->playerPos.x + agentDirX[i];
+        const int y = game->playerPos.y + agentDirY[i];
+        const int distance = GetMapDistance(&game->stairDownDistances, x, y);
+
+        if (distance < best && IsValidPlayerPosition(&game->masks, game->entities, x, y))
+        {
+            best = distance;
+            *moveX = agentDirX[i];
+            *moveY = agentDirY[i];
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+static GameInput NextAgentInput(const Game* game)
+{
+    GameInput input = { 0 };
+
+    // Let travel and auto-explore run until they stop by themselves
+    if (!game->dungeonGenerated || game->transitioningFloors || game->travel.mode != TRAVEL_NONE)
+    {
+        return input;
+    }
+
+    const int cell = game->grid[game->playerPos.y][game->playerPos.x];
+    const int roll = AgentRandom(0, 999);
+
+    if (roll < AGENT_REGENERATE_CHANCE)
+    {
+        input.regenerate = true;
+    }
+    else if (cell == CELL_STAIR_DOWN || (cell == CELL_STAIR_UP && roll < AGENT_GO_UP_CHANCE))
+    {
+        input.useStairs = true;
+    }
+    else if (roll < AGENT_REGENERATE_CHANCE + AGENT_EXPLORE_CHANCE)
+    {
+        input.explore = true;
+    }
+    else if (roll >= AGENT_WANDER_CHANCE && StepTowardStairs(game, &input.moveX, &input.moveY))
+    {
+        // Heading down
+    }
+    else
+    {
+        const int direction = AgentRandom(0, 7);
+
+        input.moveX = agentDirX[direction];
+        input.moveY = agentDirY[direction];
+    }
+
+    input.anyKey = true;
+
+    return input;
+}
+
+int main(int argc, char* argv[])
+{
+    const int turns = (argc >= 2) ? atoi(argv[1]) : SOAK_DEFAULT_TURNS;
+    const unsigned int seed = (argc >= 3) ? (unsigned int)strtoul(argv[2], NULL, 10) : SOAK_DEFAULT_SEED;
+
+    if (turns <= 0)
+    {
+        printf("Usage: %s [turns] [seed] [replay file]\n", argv[0]);
+        return 1;
+    }
+
+    StartLogger();
+
+    // Floor seeds come from raylib's generator, the agent has its own
+    SeedRandom(seed);
+    agentState ^= seed * 2654435761u;
+
+    // Far too big for the stack with all the distance maps
+    Game* game = malloc(sizeof(Game));
+
+    if (game == NULL)
+    {
+        printf("Game allocation failed!\n");
+        return 1;
+    }
+
+    *game = InitGame(0, 0);
+
+    if (game->entities == NULL || game->scheduler == NULL || game->ai == NULL)
+    {
+        printf("Game allocation failed!\n");
+        return 1;
+    }
+
+    const char* replayPath = (argc >= 4) ? argv[3] : NULL;
+
+    if (replayPath != NULL)
+    {
+        game->replay = CreateReplayRecorder();
+    }
+
+    const long long maxUpdates = (long long)turns * SOAK_UPDATES_PER_TURN;
+    long long updates = 0;
+    int floors = 0;
+    int failedFloors = 0;
+    int deepestFloor = 1;
+
+    const uint64_t start = GetClockNanoseconds();
+
+    while (game->turnCounter < turns && updates < maxUpdates)
+    {
+        const bool generating = !game->dungeonGenerated || game->transitioningFloors;
+
+        UpdateGame(game, NextAgentInput(game));
+        updates++;
+
+        if (generating)
+        {
+            if (game->dungeonGenerated && !game->transitioningFloors)
+            {
+                floors++;
+            }
+            else
+            {
+                failedFloors++;
+            }
+        }
+
+        deepestFloor = (game->currentFloor > deepestFloor) ? game->currentFloor : deepestFloor;
+    }
+
+    const double seconds = (double)(GetClockNanoseconds() - start) / 1e9;
+
+    printf("%d turns, %lld updates, %d floors (%d failed), deepest floor %d in %.2fs\n",
+           game->turnCounter, updates, floors, failedFloors, deepestFloor, seconds);
+    printf("%.0f turns/s, %.1f floors/s\n", game->turnCounter / seconds, floors / seconds);
+
+    const bool stalled = game->turnCounter < turns;
+
+    if (stalled)
+    {
+        printf("Stalled: only %d of %d turns after %lld updates!\n", game->turnCounter, turns, updates);
+    }
+
+    if (game->replay != NULL)
+    {
+        if (!SaveReplay(game->replay, replayPath, GetGameCheckpoint(game)))
+        {
+            printf("Failed to save replay %s!\n", replayPath);
+        }
+
+        DestroyReplay(game->replay);
+    }
+
+    UnloadGame(game);
+    free(game);
+
+    StopLogger();
+
+    return stalled ? 1 : 0;
+}
\ No newline at end of file
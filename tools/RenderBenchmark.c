@@ -0,0 +1,121 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Clock.h"
+#include "Game.h"
+#include "Log.h"
+#include "Random.h"
+#include "RenderRecorder.h"
+
+/* How much it costs to build a frame, with no window or GPU anywhere!
+ *
+ * Usage: RenderBenchmark [frames] [seed]
+ *
+ * DrawGame draws into the recording backend, so we measure exactly the CPU side of a frame: walking the grid,
+ * picking colours, formatting the HUD and issuing the commands. The same floor is drawn three ways,
+ * as the player first sees it, fully explored, and fully explored with everything in sight.
+ * The last one is then drawn again zoomed all the way in and out, culling should make zooming in cheaper.
+ */
+#define BENCH_DEFAULT_FRAMES 2000
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_FRAME_WIDTH 1920
+#define BENCH_FRAME_HEIGHT 1080
+#define BENCH_MAX_GENERATION_UPDATES 100
+
+static const char* const commandTypeNames[RENDER_COMMAND_TYPE_COUNT] =
+{
+    "clear", "rect", "circle", "text", "camera", "camera end", "upload", "texture"
+};
+
+static void RunScenario(const char* name, const Game* game, RenderBackend* render, RenderRecorder* recorder,
+                        int frames)
+{
+    long long typeCountsBefore[RENDER_COMMAND_TYPE_COUNT];
+    memcpy(typeCountsBefore, recorder->typeCounts, sizeof(typeCountsBefore));
+
+    const uint64_t start = GetClockNanoseconds();
+
+    for (int i = 0; i < frames; i++)
+    {
+        DrawGame(game, render);
+    }
+
+    const double microseconds = (double)(GetClockNanoseconds() - start) / 1e3 / frames;
+
+    printf("%-16s | %8.2f us/frame | %6d commands/frame |", name, microseconds, recorder->commandCount);
+
+    for (int type = 0; type < RENDER_COMMAND_TYPE_COUNT; type++)
+    {
+        printf(" %s %lld", commandTypeNames[type], (recorder->typeCounts[type] - typeCountsBefore[type]) / frames);
+    }
+
+    printf("\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const int frames = (argc >= 2) ? atoi(argv[1]) : BENCH_DEFAULT_FRAMES;
+    const unsigned int seed = (argc >= 3) ? (unsigned int)strtoul(argv[2], NULL, 10) : BENCH_DEFAULT_SEED;
+
+    if (frames <= 0)
+    {
+        printf("Usage: %s [frames] [seed]\n", argv[0]);
+        return 1;
+    }
+
+    StartLogger();
+    SeedRandom(seed);
+
+    Game* game = malloc(sizeof(Game));
+    RenderRecorder* recorder = CreateRenderRecorder(BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT);
+
+    if (game == NULL || recorder == NULL)
+    {
+        printf("Benchmark allocation failed!\n");
+        return 1;
+    }
+
+    *game = InitGame(BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT);
+
+    const GameInput noInput = { 0 };
+
+    for (int i = 0; i < BENCH_MAX_GENERATION_UPDATES && !game->dungeonGenerated; i++)
+    {
+        UpdateGame(game, noInput);
+    }
+
+    if (!game->dungeonGenerated)
+    {
+        printf("Could not generate a floor for seed %u!\n", seed);
+        return 1;
+    }
+
+    RenderBackend render = CreateRecordingRenderBackend(recorder);
+
+    printf("Floor %d (seed %u), %d rooms, %d entities, %dx%d frame, %d frames per scenario\n",
+           game->currentFloor, game->floorSeed, game->roomCount, game->entities->liveCount,
+           BENCH_FRAME_WIDTH, BENCH_FRAME_HEIGHT, frames);
+
+    RunScenario("first sight", game, &render, recorder, frames);
+
+    memset(&game->explored, 0xFF, sizeof(game->explored));
+    RunScenario("fully explored", game, &render, recorder, frames);
+
+    memset(&game->visible, 0xFF, sizeof(game->visible));
+    RunScenario("everything seen", game, &render, recorder, frames);
+
+    game->zoom = CAMERA_ZOOM_MAX;
+    RunScenario("zoomed in", game, &render, recorder, frames);
+
+    game->zoom = CAMERA_ZOOM_MIN;
+    RunScenario("zoomed out", game, &render, recorder, frames);
+
+    ReleaseMinimapTexture(game->minimap, &render);
+    UnloadGame(game);
+    free(game);
+    DestroyRenderRecorder(recorder);
+
+    StopLogger();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include "Clock.h"
+#include "Game.h"
+#include "Log.h"
+#include "Replay.h"
+
+/* Plays a recorded session back as fast as possible, no window and no rendering!
+ *
+ * Usage: ReplayRunner <replay file> [repeats]
+ *
+ * Every recorded input goes through UpdateGame again, with the recorded floor seeds, so the session
+ * (generation failures and all) happens exactly like it did. At the end the turn, floor and player position
+ * must match what was recorded, otherwise the game isn't deterministic anymore and we say so.
+ * F9 presses are part of the recording too, so a replay can write its own trace.json for profiling.
+ */
+static bool PlayReplay(const char* path, double* seconds, long long* frames, int* turns)
+{
+    Replay* replay = LoadReplay(path);
+    Game* game = malloc(sizeof(Game));
+
+    if (replay == NULL || game == NULL)
+    {
+        DestroyReplay(replay);
+        free(game);
+        return false;
+    }
+
+    *game = InitGame(0, 0);
+    game->replay = replay;
+
+    GameInput input;
+    *frames = 0;
+
+    const uint64_t start = GetClockNanoseconds();
+
+    while (ReadReplayInput(replay, &input))
+    {
+        UpdateGame(game, input);
+        (*frames)++;
+    }
+
+    *seconds = (double)(GetClockNanoseconds() - start) / 1e9;
+    *turns = game->turnCounter;
+
+    const ReplayCheckpoint expected = replay->end;
+    const ReplayCheckpoint actual = GetGameCheckpoint(game);
+    const bool matches = expected.turnCounter == actual.turnCounter && expected.currentFloor == actual.currentFloor &&
+                         expected.playerX == actual.playerX && expected.playerY == actual.playerY;
+
+    if (!matches)
+    {
+        printf("DIVERGED: recorded turn %u floor %u at (%u, %u), replayed turn %u floor %u at (%u, %u)\n",
+               expected.turnCounter, expected.currentFloor, expected.playerX, expected.playerY,
+               actual.turnCounter, actual.currentFloor, actual.playerX, actual.playerY);
+    }
+
+    UnloadGame(game);
+    free(game);
+    DestroyReplay(replay);
+
+    return matches;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s <replay file> [repeats]\n", argv[0]);
+        return 1;
+    }
+
+    const int repeats = (argc >= 3) ? atoi(argv[2]) : 1;
+
+    StartLogger();
+
+    bool allMatch = true;
+
+    for (int i = 0; i < repeats; i++)
+    {
+        double seconds = 0.0;
+        long long frames = 0;
+        int turns = 0;
+
+        allMatch = PlayReplay(argv[1], &seconds, &frames, &turns) && allMatch;
+
+        printf("%d turns in %lld frames, %.3fs, %.0f turns/s\n", turns, frames, seconds, turns / seconds);
+    }
+
+    printf(allMatch ? "Replay matches the recorded session\n" : "Replay does NOT match the recorded session!\n");
+
+    StopLogger();
+
+    return allMatch ? 0 : 1;
+}
\ No newline at end of file